@@ -0,0 +1,69 @@
+#ifndef ADC_SAMPLER_HPP
+#define ADC_SAMPLER_HPP
+
+#include <stdint.h>
+#include "Hal.hpp"
+#include "EventQueue.hpp"
+
+// Amostragem contínua do ADC em round-robin: as entradas 0..inputCount-1
+// são convertidas em sequência, cada uma na taxa pedida, e o DMA grava as
+// amostras intercaladas num buffer circular (AdcSamplerPico.cpp); a CPU só
+// lê. A amostra de índice i da entrada k fica na posição i * inputCount + k
+// da sequência; quando a contagem do DMA se esgota, read() e latest() o
+// rearmam sem zerar esses índices. No host as amostras vêm do roteiro do simulador com
+// a mesma cadência (host/AdcSamplerHost.cpp).
+class AdcSampler {
+public:
+    // Buffer circular: 2048 amostras de 16 bits, ~85 ms por entrada com 3 entradas a 8 kHz
+    static const uint32_t RING_SAMPLES = 2048;
+    static const uint32_t MAX_INPUTS = 4;
+
+    AdcSampler(uint32_t inputCount, uint32_t sampleRateHz);
+    ~AdcSampler();
+
+    void start();
+    void stop();
+
+    // Copia até 'maxCount' amostras ainda não lidas da entrada, em ordem;
+    // retorna quantas. Se o leitor atrasar mais que o buffer, pula para as mais recentes.
+    uint32_t read(uint32_t input, uint16_t *out, uint32_t maxCount);
+    // Descarta as amostras não lidas da entrada
+    void skip(uint32_t input) { readIndex[input] = samplesCaptured(input); }
+    // Amostra mais recente da entrada (0 antes da primeira)
+    uint16_t latest(uint32_t input);
+
+    // Posta EVENT_ADC_READY (source = timerId) a cada 'blockSamples' amostras por entrada
+    void enableBlockEvents(uint32_t timerId, uint32_t blockSamples) {
+        halTimerStart(timerId, EVENT_ADC_READY, (uint32_t)((uint64_t)blockSamples * 1000000 / rateHz), true);
+    }
+
+    // Amostras de uma entrada capturadas desde start() (índice da próxima)
+    uint64_t samplesCaptured(uint32_t input) const {
+        uint64_t total = totalCaptured();
+        return total > input ? (total - input + inputCount - 1) / inputCount : 0;
+    }
+    uint64_t samplesRead(uint32_t input) const { return readIndex[input]; }
+    // Blocos perdidos porque o leitor atrasou mais que o buffer
+    uint32_t overruns() const { return overrunCount; }
+    uint32_t sampleRate() const { return rateHz; }
+    // Instante (halTimeUs) da amostra de índice 'sample' de uma entrada
+    uint64_t sampleTimeUs(uint64_t sample) const { return startUs + sample * 1000000 / rateHz; }
+
+private:
+    uint32_t inputCount;
+    uint32_t rateHz;
+    int dmaChannel;
+    uint64_t startUs;
+    uint64_t readIndex[MAX_INPUTS];
+    uint64_t wrapBase;          // transferências dos rearmes anteriores do DMA (só no Pico)
+    uint32_t overrunCount;
+    bool running;
+
+    // Amostras de todas as entradas já gravadas no buffer
+    uint64_t totalCaptured() const;
+    uint16_t sampleAt(uint32_t input, uint64_t sample) const;
+    // Contagem do DMA esgotada: rearma sem zerar a contagem (só no Pico)
+    void rearmIfDone();
+};
+
+#endif // ADC_SAMPLER_HPP
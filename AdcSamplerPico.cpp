@@ -0,0 +1,113 @@
+// ADC no Pico: modo livre em round-robin, FIFO do ADC e DMA em anel
+#include "AdcSampler.hpp"
+#include "Hal.hpp"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#define ADC_CLOCK_HZ 48000000
+// Anel de escrita do DMA: 2^12 bytes = RING_SAMPLES amostras de 16 bits
+#define RING_SIZE_BITS 12
+// Contagem máxima de transferências; a 24 kHz dura ~49 h antes do rearme
+#define DMA_MAX_COUNT 0xFFFFFFFFu
+
+static uint16_t ring[AdcSampler::RING_SAMPLES] __attribute__((aligned(1 << RING_SIZE_BITS)));
+static_assert(sizeof(ring) == (1 << RING_SIZE_BITS), "anel do DMA deve ter 2^RING_SIZE_BITS bytes");
+
+AdcSampler::AdcSampler(uint32_t inputCount, uint32_t sampleRateHz)
+    : inputCount(inputCount), rateHz(sampleRateHz), dmaChannel(-1), startUs(0),
+      readIndex{0, 0, 0, 0}, wrapBase(0), overrunCount(0), running(false) {
+}
+
+AdcSampler::~AdcSampler() {
+    stop();
+}
+
+void AdcSampler::start() {
+    if (running) return;
+
+    // A sequência começa na entrada 0 e percorre as seguintes
+    adc_select_input(0);
+    adc_set_round_robin((1u << inputCount) - 1);
+    // FIFO com DREQ a cada amostra, sem bit de erro nem redução para 8 bits
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)ADC_CLOCK_HZ / (rateHz * inputCount) - 1);
+
+    dmaChannel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dmaChannel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, RING_SIZE_BITS);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(dmaChannel, &c, ring, &adc_hw->fifo, DMA_MAX_COUNT, true);
+
+    startUs = halTimeUs();
+    for (uint32_t i = 0; i < MAX_INPUTS; i++) readIndex[i] = 0;
+    wrapBase = 0;
+    running = true;
+    adc_run(true);
+}
+
+void AdcSampler::stop() {
+    if (!running) return;
+    adc_run(false);
+    adc_set_round_robin(0);
+    adc_fifo_drain();
+    dma_channel_abort(dmaChannel);
+    dma_channel_unclaim(dmaChannel);
+    dmaChannel = -1;
+    running = false;
+}
+
+uint64_t AdcSampler::totalCaptured() const {
+    if (!running) return 0;
+    return wrapBase + (DMA_MAX_COUNT - dma_channel_hw_addr(dmaChannel)->transfer_count);
+}
+
+uint16_t AdcSampler::sampleAt(uint32_t input, uint64_t sample) const {
+    return ring[(sample * inputCount + input) % RING_SAMPLES] & 0x0FFF;
+}
+
+// Fim da contagem: a FIFO pode ter transbordado enquanto o DMA estava
+// parado e desalinhado a sequência. Para o ADC, esvazia a FIFO e rearma o
+// DMA sem mexer no endereço de escrita, com a sequência na entrada da vez:
+// a contagem de amostras continua e as posições guardadas pelos leitores
+// seguem válidas. As amostras da pausa não existem; o relógio das amostras
+// avança para o instante do rearme
+void AdcSampler::rearmIfDone() {
+    if (!running || dma_channel_is_busy(dmaChannel)) return;
+    adc_run(false);
+    adc_fifo_drain();
+    wrapBase += DMA_MAX_COUNT;
+    adc_select_input(wrapBase % inputCount);
+    startUs = halTimeUs() - (wrapBase / inputCount) * 1000000 / rateHz;
+    dma_channel_set_trans_count(dmaChannel, DMA_MAX_COUNT, true);
+    adc_run(true);
+}
+
+// Os dois caminhos de leitura rearmam: o joystick só usa latest(), o
+// microfone só read()
+uint16_t AdcSampler::latest(uint32_t input) {
+    rearmIfDone();
+    uint64_t captured = samplesCaptured(input);
+    return captured ? sampleAt(input, captured - 1) : 0;
+}
+
+uint32_t AdcSampler::read(uint32_t input, uint16_t *out, uint32_t maxCount) {
+    if (!running || input >= inputCount) return 0;
+    rearmIfDone();
+
+    uint64_t captured = samplesCaptured(input);
+    uint64_t depth = RING_SAMPLES / inputCount;
+    if (captured - readIndex[input] > depth - depth / 8) {
+        overrunCount++;
+        readIndex[input] = captured - depth / 2;
+    }
+
+    uint32_t count = 0;
+    while (readIndex[input] < captured && count < maxCount) {
+        out[count++] = sampleAt(input, readIndex[input]);
+        readIndex[input]++;
+    }
+    return count;
+}
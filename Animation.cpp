@@ -0,0 +1,111 @@
+#include "Animation.hpp"
+#include "Hal.hpp"
+#include "EventLog.hpp"
+#include "EventQueue.hpp"
+
+Animator::Animator()
+    : pendingInputUs(0), inputPending(false), worstUs(0), samples(0) {
+    cancel();
+}
+
+bool Animator::play(const Keyframe *frames, uint8_t count, int16_t pixel, uint16_t delayTicks) {
+    if (count == 0) return false;
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        if (layers[i].active) continue;
+        // Camadas são desenhadas em ordem: a nova precisa ficar depois das ativas
+        bool above = true;
+        for (uint8_t j = i + 1; j < MAX_LAYERS; j++) {
+            if (layers[j].active) above = false;
+        }
+        if (!above) continue;
+        layers[i] = {frames, count, 0, frames[0].ticks, delayTicks, pixel, true};
+        return true;
+    }
+    return false;
+}
+
+void Animator::updateFrameTimer() const {
+    bool animating = isActive();
+    if (animating == halTimerActive(TIMER_FRAME)) return;
+    if (animating) halTimerStart(TIMER_FRAME, EVENT_TIMER, ANIMATION_TICK_MS * 1000, true);
+    else halTimerStop(TIMER_FRAME);
+}
+
+void Animator::cancel() {
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        layers[i].active = false;
+    }
+}
+
+bool Animator::isActive() const {
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        if (layers[i].active) return true;
+    }
+    return false;
+}
+
+uint16_t Animator::remainingTicks() const {
+    uint16_t longest = 0;
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        const Layer &layer = layers[i];
+        if (!layer.active) continue;
+        uint16_t total = layer.delay + layer.remaining;
+        for (uint8_t k = layer.index + 1; k < layer.count; k++) total += layer.frames[k].ticks;
+        if (total > longest) longest = total;
+    }
+    return longest;
+}
+
+bool Animator::advance() {
+    bool changed = false;
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        Layer &layer = layers[i];
+        if (!layer.active) continue;
+        if (layer.delay > 0) {
+            // Começa a aparecer quando o atraso termina
+            if (--layer.delay == 0) changed = true;
+            continue;
+        }
+        if (layer.remaining > 1) {
+            layer.remaining--;
+            continue;
+        }
+        changed = true;
+        if (++layer.index >= layer.count) {
+            layer.active = false;
+        } else {
+            layer.remaining = layer.frames[layer.index].ticks;
+        }
+    }
+    return changed;
+}
+
+void Animator::compose(WS2812 &strip) const {
+    for (uint8_t i = 0; i < MAX_LAYERS; i++) {
+        const Layer &layer = layers[i];
+        if (!layer.active || layer.delay > 0) continue;
+        WS2812::Color color = layer.frames[layer.index].color;
+        if (layer.pixel == WHOLE_STRIP) {
+            strip.fill(color);
+        } else {
+            strip.setPixelColor(layer.pixel, color);
+        }
+    }
+}
+
+void Animator::inputReceived(uint32_t eventUs) {
+    if (!isActive() || inputPending) return;
+    pendingInputUs = eventUs;
+    inputPending = true;
+}
+
+void Animator::frameShown() {
+    if (!inputPending) return;
+    uint32_t latency = (uint32_t)halTimeUs() - pendingInputUs;
+    inputPending = false;
+    samples++;
+    if (latency > worstUs) {
+        worstUs = latency;
+        logEvent(LOG_ANIMATION_LATENCY, (int32_t)worstUs, (int32_t)samples);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef ANIMATION_HPP
+#define ANIMATION_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+
+// Período do alarme de quadros das animações (TIMER_FRAME)
+#define ANIMATION_TICK_MS 20
+
+// Quadro-chave: cor já codificada (WS2812::color) mantida por 'ticks' períodos do relógio
+typedef struct {
+    WS2812::Color color;
+    uint16_t ticks;
+} Keyframe;
+
+// Animações como máquinas de estado avançadas a cada tick e desenhadas em
+// camadas sobre o tabuleiro. Qualquer entrada pode cancelá-las.
+class Animator {
+public:
+    static const uint8_t MAX_LAYERS = 4;
+    static const int16_t WHOLE_STRIP = -1;
+
+    Animator();
+
+    // Toca a sequência num pixel (ou na fita inteira) depois de 'delayTicks'.
+    // Camadas mais novas ficam por cima. Retorna false se não há camada livre.
+    bool play(const Keyframe *frames, uint8_t count, int16_t pixel, uint16_t delayTicks = 0);
+    void cancel();
+    bool isActive() const;
+    // Ticks até a última camada terminar (para encadear animações)
+    uint16_t remainingTicks() const;
+
+    // Avança um tick; retorna true se o quadro visível mudou
+    bool advance();
+    // Liga o alarme de quadros só enquanto há camada tocando
+    void updateFrameTimer() const;
+    // Desenha as camadas visíveis sobre o conteúdo atual da fita
+    void compose(WS2812 &strip) const;
+
+    // Latência entre uma entrada recebida durante uma animação (instante da
+    // interrupção, InputAction::timeUs) e o quadro seguinte enviado aos LEDs
+    void inputReceived(uint32_t eventUs);
+    void frameShown();
+    uint32_t worstLatencyUs() const { return worstUs; }
+    uint32_t latencySamples() const { return samples; }
+
+private:
+    typedef struct {
+        const Keyframe *frames;
+        uint8_t count;
+        uint8_t index;
+        uint16_t remaining;   // ticks restantes do quadro-chave atual
+        uint16_t delay;       // ticks até começar
+        int16_t pixel;
+        bool active;
+    } Layer;
+
+    Layer layers[MAX_LAYERS];
+    uint32_t pendingInputUs;
+    bool inputPending;
+    uint32_t worstUs;
+    uint32_t samples;
+};
+
+#endif // ANIMATION_HPP
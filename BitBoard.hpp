@@ -0,0 +1,98 @@
+#ifndef BIT_BOARD_HPP
+#define BIT_BOARD_HPP
+
+#include <stdint.h>
+
+// Estrutura para representar uma posição no tabuleiro
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} Position;
+
+// Tabuleiro 3x3 representado por duas máscaras de 9 bits, uma por jogador.
+// A célula (x, y) corresponde ao bit y * 3 + x. Jogador 1 = IA, 2 = Humano.
+// Não depende do Pico SDK, então também compila para o host.
+class BitBoard {
+public:
+    static constexpr uint8_t CELL_COUNT = 9;
+    static constexpr uint16_t FULL_MASK = 0x1FF;
+    static constexpr uint8_t WIN_LINE_COUNT = 8;
+
+    // As 8 linhas vencedoras: 3 linhas, 3 colunas e 2 diagonais
+    static constexpr uint16_t WIN_LINES[WIN_LINE_COUNT] = {
+        0x007, 0x038, 0x1C0,   // linhas
+        0x049, 0x092, 0x124,   // colunas
+        0x111, 0x054           // diagonais
+    };
+
+    BitBoard() : masks{0, 0} {}
+
+    static uint8_t cellIndex(uint8_t x, uint8_t y) {
+        return y * 3 + x;
+    }
+
+    static bool isWinningMask(uint16_t mask) {
+        for (uint8_t i = 0; i < WIN_LINE_COUNT; i++) {
+            if ((mask & WIN_LINES[i]) == WIN_LINES[i]) return true;
+        }
+        return false;
+    }
+
+    void clear() {
+        masks[0] = 0;
+        masks[1] = 0;
+    }
+
+    // Retorna 0 = vazio, 1 = IA, 2 = Humano
+    uint8_t get(uint8_t cell) const {
+        uint16_t bit = 1u << cell;
+        if (masks[0] & bit) return 1;
+        if (masks[1] & bit) return 2;
+        return 0;
+    }
+
+    uint8_t get(uint8_t x, uint8_t y) const {
+        return get(cellIndex(x, y));
+    }
+
+    bool isEmpty(uint8_t cell) const {
+        return !(occupiedMask() & (1u << cell));
+    }
+
+    uint16_t playerMask(uint8_t player) const {
+        return masks[player - 1];
+    }
+
+    uint16_t occupiedMask() const {
+        return masks[0] | masks[1];
+    }
+
+    uint16_t emptyMask() const {
+        return ~occupiedMask() & FULL_MASK;
+    }
+
+    uint8_t moveCount() const {
+        return __builtin_popcount(occupiedMask());
+    }
+
+    void makeMove(uint8_t cell, uint8_t player) {
+        masks[player - 1] |= (uint16_t)(1u << cell);
+    }
+
+    void unmakeMove(uint8_t cell, uint8_t player) {
+        masks[player - 1] &= (uint16_t)~(1u << cell);
+    }
+
+    bool checkWin(uint8_t player) const {
+        return isWinningMask(masks[player - 1]);
+    }
+
+    bool isFull() const {
+        return moveCount() == CELL_COUNT;
+    }
+
+private:
+    uint16_t masks[2];
+};
+
+#endif // BIT_BOARD_HPP
@@ -0,0 +1,39 @@
+#ifndef BOARD_PALETTE_HPP
+#define BOARD_PALETTE_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+#include "Animation.hpp"
+
+// Cores e animações comuns aos jogos, às placas IA x IA e ao modo motor.
+// Valores perceptuais: a curva gama da fita leva 97 a 30 e 28 a 2. Como
+// são inline constexpr, há uma só cópia no firmware.
+inline constexpr WS2812::Color COLOR_GRID = WS2812::color(28, 28, 0);
+inline constexpr WS2812::Color COLOR_CURSOR_MIC = WS2812::color(97, 0, 97);  // cursor no modo microfone
+inline constexpr WS2812::Color COLOR_PLAYER1 = WS2812::color(97, 0, 0);
+inline constexpr WS2812::Color COLOR_PLAYER2 = WS2812::color(0, 0, 97);
+inline constexpr WS2812::Color COLOR_DRAW = WS2812::color(81, 81, 0);
+inline constexpr WS2812::Color COLOR_OFF = WS2812::color(0, 0, 0);
+
+// Animações, com durações em ticks do relógio de quadros; índice = jogador - 1
+inline constexpr Keyframe WIN_FRAMES[2][5] = {
+    {{COLOR_PLAYER1, 200 / ANIMATION_TICK_MS}, {COLOR_OFF, 200 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER1, 200 / ANIMATION_TICK_MS}, {COLOR_OFF, 200 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER1, 200 / ANIMATION_TICK_MS}},
+    {{COLOR_PLAYER2, 200 / ANIMATION_TICK_MS}, {COLOR_OFF, 200 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER2, 200 / ANIMATION_TICK_MS}, {COLOR_OFF, 200 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER2, 200 / ANIMATION_TICK_MS}}
+};
+inline constexpr Keyframe DRAW_FRAMES[3] = {
+    {COLOR_DRAW, 300 / ANIMATION_TICK_MS}, {COLOR_OFF, 300 / ANIMATION_TICK_MS},
+    {COLOR_DRAW, 300 / ANIMATION_TICK_MS}
+};
+// Pisca a casa recém-jogada
+inline constexpr Keyframe FLASH_FRAMES[2][3] = {
+    {{COLOR_PLAYER1, 100 / ANIMATION_TICK_MS}, {COLOR_OFF, 100 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER1, 100 / ANIMATION_TICK_MS}},
+    {{COLOR_PLAYER2, 100 / ANIMATION_TICK_MS}, {COLOR_OFF, 100 / ANIMATION_TICK_MS},
+     {COLOR_PLAYER2, 100 / ANIMATION_TICK_MS}}
+};
+
+#endif // BOARD_PALETTE_HPP
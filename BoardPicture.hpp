@@ -0,0 +1,37 @@
+#ifndef BOARD_PICTURE_HPP
+#define BOARD_PICTURE_HPP
+
+#include <stdint.h>
+#include "FrameBuffer.hpp"
+
+static_assert(PanelLayout::WIDTH >= 5 && PanelLayout::HEIGHT >= 5, "o tabuleiro precisa de um painel de 5x5 ou mais");
+
+// Tabuleiro 3x3 desenhado numa área 5x5: casas nas linhas e colunas pares,
+// grade nas ímpares. Em painéis maiores a área fica no centro.
+class BoardPicture {
+public:
+    static const uint8_t SIZE = 5;
+
+    static void attach(FrameBuffer& frame) {
+        frame.centerArea(SIZE, SIZE);
+    }
+
+    static void drawGrid(FrameBuffer& frame, WS2812Base::Color color) {
+        frame.fillRect(1, 0, 1, SIZE, color);
+        frame.fillRect(3, 0, 1, SIZE, color);
+        frame.fillRect(0, 1, SIZE, 1, color);
+        frame.fillRect(0, 3, SIZE, 1, color);
+    }
+
+    // Casa pelo índice y * 3 + x
+    static void setCell(FrameBuffer& frame, uint8_t cell, WS2812Base::Color color) {
+        frame.setPixel(2 * (cell % 3), 2 * (cell / 3), color);
+    }
+
+    // LED da casa, para Animator::play
+    static int16_t cellPixel(const FrameBuffer& frame, uint8_t cell) {
+        return frame.index(2 * (cell % 3), 2 * (cell / 3));
+    }
+};
+
+#endif // BOARD_PICTURE_HPP
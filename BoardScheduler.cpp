@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include "BoardScheduler.hpp"
+#include "Hal.hpp"
+#include "EventQueue.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+#include "SolvedTable.hpp"
+#include "BoardPicture.hpp"
+#include "BoardPalette.hpp"
+
+#define MOVE_TICKS 15           // ~300 ms entre jogadas
+#define MOVE_JITTER_TICKS 16    // sorteados por jogada, para as placas não andarem juntas
+#define RESTART_TICKS 25        // pausa antes da partida seguinte
+#define STRIP_RETRY_US 500      // nova tentativa de show() numa fita ocupada
+
+static const char *const PLAYER_NAMES[3] = {"tabela", "negamax", "aleatório"};
+
+// Tabuleiro no centro do painel da fita
+static FrameBuffer boardFrame(WS2812 &strip) {
+    FrameBuffer frame(strip);
+    BoardPicture::attach(frame);
+    return frame;
+}
+
+static uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static uint8_t pickMove(uint16_t moves, uint32_t &rng) {
+    uint8_t choice = nextRandom(rng) % __builtin_popcount(moves);
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!(moves & (1u << cell))) continue;
+        if (choice-- == 0) return cell;
+    }
+    return BitBoard::CELL_COUNT;
+}
+
+BoardScheduler::BoardScheduler() : count(0), blockingShow(false), runUs(0), ticks(0) {
+}
+
+bool BoardScheduler::addBoard(WS2812 &strip, PlayerKind first, PlayerKind second) {
+    if (count >= SCHEDULER_MAX_BOARDS || !strip.hasOutput()) return false;
+    Board &b = boards[count];
+    b.strip = &strip;
+    b.board.clear();
+    b.players[0] = first;
+    b.players[1] = second;
+    b.currentPlayer = 1;
+    b.active = true;
+    b.wait = MOVE_TICKS + count * 3;
+    b.dirty = false;
+    b.deferred = false;
+    b.dirtySinceUs = 0;
+    b.rng = 0x9E3779B9u * (count + 1) ^ (uint32_t)halTimeUs();
+    if (b.rng == 0) b.rng = 1;
+    b.stats = BoardStats();
+    count++;
+    return true;
+}
+
+void BoardScheduler::resetStats() {
+    for (uint8_t i = 0; i < count; i++) boards[i].stats = BoardStats();
+    runUs = 0;
+    ticks = 0;
+}
+
+void BoardScheduler::run(uint32_t durationMs) {
+    uint64_t start = halTimeUs();
+    halTimerStart(TIMER_FRAME, EVENT_TIMER, ANIMATION_TICK_MS * 1000, true);
+    for (uint8_t i = 0; i < count; i++) {
+        draw(boards[i]);
+        boards[i].dirty = true;
+        boards[i].dirtySinceUs = (uint32_t)start;
+    }
+
+    while (halRunning() && (durationMs == 0 || halTimeUs() - start < (uint64_t)durationMs * 1000)) {
+        PROBE_SCOPE(PROBE_LOOP);
+        Event event;
+        while (eventPop(event)) {
+            if (event.type == EVENT_TIMER && event.source == TIMER_FRAME) tick(event.timeUs);
+            // TIMER_STRIP só acorda o laço para refresh()
+        }
+        // Fita ainda ocupada: volta logo, sem esperar o próximo tick
+        if (refresh() && !halTimerActive(TIMER_STRIP))
+            halTimerStart(TIMER_STRIP, EVENT_TIMER, STRIP_RETRY_US, false);
+        PROBE_STOP();
+        logFlush();
+        probePollCommands();
+
+        halWaitForEvent();
+    }
+
+    halTimerStop(TIMER_FRAME);
+    halTimerStop(TIMER_STRIP);
+    runUs += (uint32_t)(halTimeUs() - start);
+}
+
+// Um tick em todas as placas; a latência de cada quadro conta a partir do
+// tick que o mudou
+void BoardScheduler::tick(uint32_t timeUs) {
+    ticks++;
+    for (uint8_t i = 0; i < count; i++) {
+        Board &b = boards[i];
+        if (!step(b)) continue;
+        draw(b);
+        if (!b.dirty) {
+            b.dirty = true;
+            b.dirtySinceUs = timeUs;
+        }
+    }
+}
+
+// Avança animações e a partida; true se o quadro mudou
+bool BoardScheduler::step(Board &b) {
+    bool changed = b.animator.advance();
+    if (b.wait > 0) {
+        b.wait--;
+        return changed;
+    }
+    if (b.animator.isActive()) return changed;
+
+    if (!b.active) {
+        b.board.clear();
+        b.currentPlayer = 1;
+        b.active = true;
+        b.wait = MOVE_TICKS;
+        return true;
+    }
+
+    uint8_t cell = chooseMove(b);
+    if (cell >= BitBoard::CELL_COUNT) return changed;
+    uint8_t player = b.currentPlayer;
+    b.board.makeMove(cell, player);
+    b.animator.play(FLASH_FRAMES[player - 1], 3, BoardPicture::cellPixel(boardFrame(*b.strip), cell));
+    b.wait = MOVE_TICKS + nextRandom(b.rng) % MOVE_JITTER_TICKS;
+
+    if (b.board.checkWin(player)) {
+        b.animator.play(WIN_FRAMES[player - 1], 5, Animator::WHOLE_STRIP, b.animator.remainingTicks());
+        b.stats.wins[player - 1]++;
+    } else if (b.board.isFull()) {
+        b.animator.play(DRAW_FRAMES, 3, Animator::WHOLE_STRIP, b.animator.remainingTicks());
+    } else {
+        b.currentPlayer = (player == 1) ? 2 : 1;
+        return true;
+    }
+    b.stats.games++;
+    b.active = false;
+    b.wait = RESTART_TICKS;
+    return true;
+}
+
+uint8_t BoardScheduler::chooseMove(Board &b) {
+    switch (b.players[b.currentPlayer - 1]) {
+    case PLAYER_TABLE: {
+        PROBE_SCOPE(PROBE_AI);
+        return pickMove(solvedBestMoves(solvedLookup(b.board)), b.rng);
+    }
+    case PLAYER_NEGAMAX: {
+        PROBE_SCOPE(PROBE_AI);
+        SearchResult result;
+        if (!ai.search(b.board, b.currentPlayer, result)) return BitBoard::CELL_COUNT;
+        return pickMove(result.bestMoves, b.rng);
+    }
+    case PLAYER_RANDOM:
+    default:
+        return pickMove(b.board.emptyMask(), b.rng);
+    }
+}
+
+// Grade, peças e animações no buffer de desenho da fita; o envio é em refresh()
+void BoardScheduler::draw(Board &b) {
+    PROBE_SCOPE(PROBE_DRAW);
+    FrameBuffer frame = boardFrame(*b.strip);
+    frame.clear(COLOR_OFF);
+    BoardPicture::drawGrid(frame, COLOR_GRID);
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        uint8_t player = b.board.get(cell);
+        if (player) BoardPicture::setCell(frame, cell, player == 1 ? COLOR_PLAYER1 : COLOR_PLAYER2);
+    }
+    b.animator.compose(*b.strip);
+}
+
+// Envia os quadros pendentes das fitas livres; true se alguma ficou para depois
+bool BoardScheduler::refresh() {
+    bool pending = false;
+    for (uint8_t i = 0; i < count; i++) {
+        Board &b = boards[i];
+        if (!b.dirty) continue;
+        if (!blockingShow && b.strip->isBusy()) {
+            if (!b.deferred) b.stats.deferred++;
+            b.deferred = true;
+            pending = true;
+            continue;
+        }
+        b.strip->show();
+        // show() volta com o envio já iniciado (depois de esperar a fita, se bloqueante)
+        uint32_t latency = (uint32_t)halTimeUs() - b.dirtySinceUs;
+        b.animator.frameShown();
+        b.dirty = false;
+        b.deferred = false;
+        b.stats.frames++;
+        b.stats.totalLatencyUs += latency;
+        if (latency > b.stats.maxLatencyUs) b.stats.maxLatencyUs = latency;
+    }
+    return pending;
+}
+
+void BoardScheduler::printStats() const {
+    double seconds = runUs / 1e6;
+    printf("Placas: %u em %.1f s (%s), %.1f ticks/s\n", count, seconds,
+           blockingShow ? "show bloqueante" : "show adiado", seconds > 0 ? ticks / seconds : 0.0);
+    printf("placa  jogadores              partidas  quadros/s  adiados  latência média/máx (us)\n");
+    for (uint8_t i = 0; i < count; i++) {
+        const Board &b = boards[i];
+        const BoardStats &s = b.stats;
+        char players[32];
+        snprintf(players, sizeof(players), "%s x %s", PLAYER_NAMES[b.players[0]], PLAYER_NAMES[b.players[1]]);
+        printf("%5u  %-22s %8lu %10.1f %8lu %10lu %8lu\n", i, players, (unsigned long)s.games,
+               seconds > 0 ? s.frames / seconds : 0.0, (unsigned long)s.deferred,
+               (unsigned long)(s.frames ? s.totalLatencyUs / s.frames : 0), (unsigned long)s.maxLatencyUs);
+    }
+    for (uint block = 0; block < WS2812_PIO_BLOCKS; block++) {
+        const WS2812Base::PioBlockStats &pio = WS2812Base::pioBlockStats(block);
+        printf("PIO%u: %u fitas, programa carregado %u vez(es)\n", block, pio.strips, pio.programLoads);
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef BOARD_SCHEDULER_HPP
+#define BOARD_SCHEDULER_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+#include "BitBoard.hpp"
+#include "Animation.hpp"
+#include "TicTacToeAI.hpp"
+
+// Uma placa por máquina de estados PIO (2 blocos x 4)
+#define SCHEDULER_MAX_BOARDS 8
+
+// Jogador automático de cada lado de uma placa
+typedef enum : uint8_t {
+    PLAYER_TABLE = 0,           // tabela resolvida, sorteio entre as jogadas ótimas
+    PLAYER_NEGAMAX,             // busca TicTacToeAI
+    PLAYER_RANDOM               // casa vazia sorteada
+} PlayerKind;
+
+// Medidas de uma placa desde o último resetStats()
+typedef struct {
+    uint32_t games;
+    uint32_t wins[2];           // vitórias de quem começa e do segundo
+    uint32_t frames;            // quadros enviados
+    uint32_t deferred;          // quadros adiados porque a fita ainda enviava o anterior
+    uint32_t maxLatencyUs;      // do tick que mudou o quadro ao início do envio
+    uint64_t totalLatencyUs;
+} BoardStats;
+
+// Várias placas 3x3 independentes, cada uma com a sua fita e os seus
+// jogadores, rodando lado a lado num só laço. Um alarme de quadros avança
+// todas as placas; a fita de cada uma só recebe show() quando está livre,
+// então uma fita ainda enviando (ou travando) o quadro anterior adia só a
+// própria placa, sem segurar as outras.
+class BoardScheduler {
+public:
+    BoardScheduler();
+
+    // false se já há SCHEDULER_MAX_BOARDS placas ou a fita não tem saída
+    bool addBoard(WS2812 &strip, PlayerKind first, PlayerKind second);
+    uint8_t boardCount() const { return count; }
+
+    // Para comparação: show() na hora, esperando a fita (caminho antigo)
+    void setBlockingShow(bool blocking) { blockingShow = blocking; }
+
+    // Roda por 'durationMs' (0 = até o fim da simulação; no Pico, sempre)
+    void run(uint32_t durationMs = 0);
+
+    const BoardStats &stats(uint8_t board) const { return boards[board].stats; }
+    uint32_t elapsedUs() const { return runUs; }
+    // Ticks tratados; abaixo de 1 por ANIMATION_TICK_MS, o laço perdeu alarmes
+    uint32_t tickCount() const { return ticks; }
+    void resetStats();
+    void printStats() const;
+
+private:
+    typedef struct {
+        WS2812 *strip;
+        BitBoard board;
+        Animator animator;
+        PlayerKind players[2];
+        uint8_t currentPlayer;
+        bool active;
+        uint16_t wait;          // ticks até a próxima jogada
+        bool dirty;             // quadro desenhado e ainda não enviado
+        bool deferred;          // já contado como adiado
+        uint32_t dirtySinceUs;
+        uint32_t rng;
+        BoardStats stats;
+    } Board;
+
+    Board boards[SCHEDULER_MAX_BOARDS];
+    uint8_t count;
+    bool blockingShow;
+    uint32_t runUs;
+    uint32_t ticks;
+    TicTacToeAI ai;             // compartilhada: as placas jogam uma de cada vez
+
+    void tick(uint32_t timeUs);
+    bool step(Board &b);
+    uint8_t chooseMove(Board &b);
+    void draw(Board &b);
+    bool refresh();
+};
+
+#endif // BOARD_SCHEDULER_HPP
@@ -0,0 +1,115 @@
+#ifndef BOARD_SYMMETRY_HPP
+#define BOARD_SYMMETRY_HPP
+
+#include <stdint.h>
+#include "BitBoard.hpp"
+
+// Posição reduzida à forma canônica: 'key' no formato de chave da IA
+// (9 bits da IA seguidos dos 9 bits do humano) e a simetria que leva o
+// tabuleiro real à forma canônica
+typedef struct {
+    uint32_t key;
+    uint8_t symmetry;
+} CanonicalPosition;
+
+// As 8 simetrias do tabuleiro 3x3 (rotações e reflexões) como permutações
+// de bits. As duas máscaras são empacotadas numa palavra de 32 bits (IA nos
+// bits 0-8, humano nos bits 16-24) e cada reflexão é um punhado de
+// deslocamentos e máscaras aplicados às duas ao mesmo tempo.
+// Simetria s = transposição se s & 4, depois espelho horizontal se s & 1,
+// depois espelho vertical se s & 2. A forma canônica é a imagem de menor
+// valor, então posições equivalentes por simetria dividem uma só entrada
+// em tabelas e caches (765 classes para as 5478 posições alcançáveis).
+class BoardSymmetry {
+public:
+    static constexpr uint8_t COUNT = 8;
+    static constexpr uint8_t IDENTITY = 0;
+
+    static constexpr uint32_t pack(uint16_t ai, uint16_t human) {
+        return (uint32_t)ai | ((uint32_t)human << 16);
+    }
+    static uint32_t pack(const BitBoard& board) {
+        return pack(board.playerMask(1), board.playerMask(2));
+    }
+    // Chave da posição: 9 bits da IA seguidos dos 9 bits do humano.
+    // A ordem da forma canônica é a da palavra empacotada, não a da chave.
+    static constexpr uint32_t key(uint32_t packed) {
+        return ((packed & BitBoard::FULL_MASK) << 9) | (packed >> 16);
+    }
+
+    // Troca as colunas 0 e 2
+    static constexpr uint32_t flipX(uint32_t w) {
+        return (w & both(0x092)) | ((w & both(0x049)) << 2) | ((w >> 2) & both(0x049));
+    }
+    // Troca as linhas 0 e 2
+    static constexpr uint32_t flipY(uint32_t w) {
+        return (w & both(0x038)) | ((w & both(0x007)) << 6) | ((w >> 6) & both(0x007));
+    }
+    // Troca x e y (diagonal principal fixa)
+    static constexpr uint32_t transpose(uint32_t w) {
+        return (w & both(0x111)) | ((w & both(0x022)) << 2) | ((w >> 2) & both(0x022)) |
+               ((w & both(0x004)) << 4) | ((w >> 4) & both(0x004));
+    }
+
+    static constexpr uint32_t apply(uint8_t symmetry, uint32_t w) {
+        if (symmetry & 4) w = transpose(w);
+        if (symmetry & 1) w = flipX(w);
+        if (symmetry & 2) w = flipY(w);
+        return w;
+    }
+    static constexpr uint16_t applyMask(uint8_t symmetry, uint16_t mask) {
+        return (uint16_t)apply(symmetry, mask);
+    }
+
+    // Com transposição, X e Y trocam de lugar ao inverter (T X = Y T)
+    static constexpr uint8_t inverse(uint8_t symmetry) {
+        return (symmetry & 4) ? (uint8_t)(4 | ((symmetry & 1) << 1) | ((symmetry >> 1) & 1)) : symmetry;
+    }
+
+    // Casa do tabuleiro real na forma canônica, e de volta
+    static constexpr uint8_t toCanonical(uint8_t symmetry, uint8_t cell) {
+        return CELL_MAP[symmetry][cell];
+    }
+    static constexpr uint8_t fromCanonical(uint8_t symmetry, uint8_t cell) {
+        return CELL_MAP[inverse(symmetry)][cell];
+    }
+
+    // Menor das 8 imagens: uma transposição e seis reflexões
+    static constexpr CanonicalPosition canonical(uint32_t w) {
+        uint32_t t = transpose(w);
+        uint32_t images[COUNT] = {w, flipX(w), flipY(w), 0, t, flipX(t), flipY(t), 0};
+        images[3] = flipY(images[1]);
+        images[7] = flipY(images[5]);
+        uint8_t best = 0;
+        for (uint8_t s = 1; s < COUNT; s++)
+            if (images[s] < images[best]) best = s;
+        return {key(images[best]), best};
+    }
+    static CanonicalPosition canonical(const BitBoard& board) {
+        return canonical(pack(board));
+    }
+
+private:
+    static constexpr uint32_t both(uint32_t mask) {
+        return mask | (mask << 16);
+    }
+
+    struct CellMap {
+        uint8_t cells[COUNT][BitBoard::CELL_COUNT];
+        constexpr const uint8_t* operator[](uint8_t s) const { return cells[s]; }
+    };
+
+    static constexpr CellMap buildCellMap() {
+        CellMap map = {};
+        for (uint8_t s = 0; s < COUNT; s++)
+            for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++)
+                map.cells[s][cell] = (uint8_t)__builtin_ctz(apply(s, 1u << cell));
+        return map;
+    }
+
+    static const CellMap CELL_MAP;
+};
+
+inline constexpr BoardSymmetry::CellMap BoardSymmetry::CELL_MAP = BoardSymmetry::buildCellMap();
+
+#endif // BOARD_SYMMETRY_HPP
@@ -0,0 +1,86 @@
+#include "ClapDetector.hpp"
+
+// Constantes de tempo dos filtros em potências de 2 de amostras (8 kHz)
+#define BASELINE_SHIFT 10      // ~128 ms
+#define ATTACK_SHIFT 1         // ~0,25 ms
+#define RELEASE_SHIFT 6        // ~8 ms
+#define NOISE_SHIFT 12         // ~0,5 s
+#define NOISE_FACTOR 4
+// O envelope precisa cair abaixo desta fração do limiar para rearmar
+#define REARM_DIVISOR 2
+
+ClapDetector::ClapDetector(const ClapConfig &config)
+    : config(config) {
+    minIntervalSamples = msToSamples(config.minIntervalMs);
+    gapSamples = msToSamples(config.gapTimeoutMs);
+    windowSamples = msToSamples(config.gestureWindowMs);
+    reset();
+}
+
+void ClapDetector::reset() {
+    baseline = -1;
+    envelope = 0;
+    noiseFloor = 0;
+    aboveThreshold = false;
+    processed = 0;
+    onsets = 0;
+    lastOnset = 0;
+    pendingClaps = 0;
+    gestureStart = 0;
+}
+
+uint32_t ClapDetector::process(const uint16_t *samples, uint32_t count) {
+    uint32_t found = 0;
+    int32_t threshold = (int32_t)config.thresholdCounts << 8;
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t x = (int32_t)samples[i] << 8;
+        if (baseline < 0) baseline = x;
+
+        int32_t rectified = x - baseline;
+        if (rectified < 0) rectified = -rectified;
+
+        if (rectified > envelope) envelope += (rectified - envelope) >> ATTACK_SHIFT;
+        else envelope -= (envelope - rectified) >> RELEASE_SHIFT;
+
+        int32_t level = noiseFloor * NOISE_FACTOR;
+        if (level < threshold) level = threshold;
+
+        uint64_t index = processed + i;
+        if (!aboveThreshold) {
+            if (envelope > level && (onsets == 0 || index - lastOnset >= minIntervalSamples)) {
+                aboveThreshold = true;
+                lastOnset = index;
+                onsets++;
+                found++;
+                if (pendingClaps == 0) gestureStart = index;
+                if (pendingClaps < 255) pendingClaps++;
+            } else {
+                // Ruído de fundo e linha de base só acompanham fora das palmas
+                noiseFloor += (envelope - noiseFloor) >> NOISE_SHIFT;
+                baseline += (x - baseline) >> BASELINE_SHIFT;
+            }
+        } else if (envelope < level / REARM_DIVISOR) {
+            aboveThreshold = false;
+        } else if (index - lastOnset >= windowSamples) {
+            // Nível preso acima do limiar (degrau de DC, não palma): a linha de base segue
+            baseline += (x - baseline) >> BASELINE_SHIFT;
+        }
+    }
+    processed += count;
+    return found;
+}
+
+bool ClapDetector::poll(ClapEvent &event) {
+    if (pendingClaps == 0 || aboveThreshold) return false;
+    bool silent = processed - lastOnset >= gapSamples;
+    bool tooLong = processed - gestureStart >= windowSamples;
+    if (!silent && !tooLong) return false;
+
+    event.gesture = (pendingClaps == 1) ? CLAP_SINGLE : CLAP_DOUBLE;
+    event.claps = pendingClaps;
+    event.firstSample = gestureStart;
+    event.lastSample = lastOnset;
+    pendingClaps = 0;
+    return true;
+}
@@ -0,0 +1,89 @@
+#ifndef CLAP_DETECTOR_HPP
+#define CLAP_DETECTOR_HPP
+
+#include <stdint.h>
+
+// Ajustes do modo microfone
+#define CLAP_SAMPLE_RATE_HZ 8000
+#define CLAP_ADC_VREF 3.3f
+#define CLAP_ADC_RANGE (1 << 12)
+#define CLAP_THRESHOLD_VOLTS 0.3f   // amplitude da palma acima da linha de base
+#define CLAP_WINDOW_MS 1000         // duração máxima de um gesto
+#define CLAP_GAP_TIMEOUT_MS 350     // silêncio após a última palma que fecha o gesto
+#define CLAP_MIN_INTERVAL_MS 80     // palmas mais próximas contam como uma
+
+// Parâmetros do detector; tempos em ms, limiar em contagens do ADC (12 bits)
+typedef struct {
+    uint32_t sampleRateHz;
+    uint16_t thresholdCounts;   // amplitude do envelope acima da linha de base
+    uint16_t gestureWindowMs;   // duração máxima de um gesto (primeira à última palma)
+    uint16_t gapTimeoutMs;      // silêncio após a última palma que encerra o gesto
+    uint16_t minIntervalMs;     // intervalo mínimo entre duas palmas
+} ClapConfig;
+
+typedef enum {
+    CLAP_NONE = 0,
+    CLAP_SINGLE,               // uma palma: move o cursor
+    CLAP_DOUBLE                // duas ou mais: joga
+} ClapGesture;
+
+typedef struct {
+    ClapGesture gesture;
+    uint8_t claps;
+    uint64_t firstSample;       // índice da amostra do início da primeira palma
+    uint64_t lastSample;        // índice da amostra do início da última palma
+} ClapEvent;
+
+// Detector de palmas por envelope, processando blocos contínuos de
+// amostras. Tudo em inteiros: linha de base (DC) por filtro de um polo,
+// envelope do sinal retificado com ataque rápido e liberação lenta, e
+// início de palma quando o envelope cruza o limiar (ou 4x o ruído de
+// fundo, o que for maior). As palmas são agrupadas em gestos.
+// Não depende do Pico SDK: o mesmo código roda no firmware e no host.
+class ClapDetector {
+public:
+    ClapDetector(const ClapConfig &config);
+    void reset();
+
+    // Processa amostras consecutivas; retorna quantas palmas começaram no bloco
+    uint32_t process(const uint16_t *samples, uint32_t count);
+    // Gesto encerrado até a última amostra processada
+    bool poll(ClapEvent &event);
+
+    uint64_t samplesProcessed() const { return processed; }
+    uint32_t onsetCount() const { return onsets; }
+    uint64_t lastOnsetSample() const { return lastOnset; }
+    uint32_t msToSamples(uint32_t ms) const { return (uint32_t)((uint64_t)ms * config.sampleRateHz / 1000); }
+    uint64_t samplesToUs(uint64_t samples) const { return samples * 1000000 / config.sampleRateHz; }
+
+private:
+    ClapConfig config;
+    uint32_t minIntervalSamples;
+    uint32_t gapSamples;
+    uint32_t windowSamples;
+
+    int32_t baseline;           // linha de base, contagens << 8
+    int32_t envelope;           // contagens << 8
+    int32_t noiseFloor;         // contagens << 8
+    bool aboveThreshold;
+    uint64_t processed;
+    uint32_t onsets;
+    uint64_t lastOnset;
+
+    // Gesto em andamento
+    uint8_t pendingClaps;
+    uint64_t gestureStart;
+};
+
+// Configuração usada pelo firmware
+static inline ClapConfig clapDefaultConfig() {
+    ClapConfig config;
+    config.sampleRateHz = CLAP_SAMPLE_RATE_HZ;
+    config.thresholdCounts = (uint16_t)(CLAP_THRESHOLD_VOLTS * (CLAP_ADC_RANGE - 1) / CLAP_ADC_VREF);
+    config.gestureWindowMs = CLAP_WINDOW_MS;
+    config.gapTimeoutMs = CLAP_GAP_TIMEOUT_MS;
+    config.minIntervalMs = CLAP_MIN_INTERVAL_MS;
+    return config;
+}
+
+#endif // CLAP_DETECTOR_HPP
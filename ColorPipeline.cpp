@@ -0,0 +1,76 @@
+#include "ColorPipeline.hpp"
+
+constexpr GammaTable GAMMA_BUILT = GammaTable::build();
+const GammaTable GAMMA_TABLE = GAMMA_BUILT;
+
+static_assert(GAMMA_BUILT.values[0] == 0 && GAMMA_BUILT.values[255] == 255, "extremos da curva gama");
+static_assert(GAMMA_BUILT.values[97] == 30, "cor dos jogadores: 97 -> 30");
+
+// Soma dos 4 bytes de uma palavra, sem laço
+static inline uint32_t byteSum(uint32_t word) {
+    uint32_t pairs = (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+    return (pairs & 0xFFFF) + (pairs >> 16);
+}
+
+ColorPipeline::ColorPipeline()
+    : level(255), gammaEnabled(true), budgetMa(0) {
+    rebuild();
+}
+
+void ColorPipeline::setBrightness(uint8_t value) {
+    level = value;
+    rebuild();
+}
+
+void ColorPipeline::setGammaEnabled(bool enabled) {
+    gammaEnabled = enabled;
+    rebuild();
+}
+
+void ColorPipeline::rebuild() {
+    for (uint32_t v = 0; v < 256; v++) {
+        uint32_t scaled = (v * level + 127) / 255;
+        lut[v] = gammaEnabled ? GAMMA_TABLE.values[scaled] : (uint8_t)scaled;
+    }
+}
+
+uint32_t ColorPipeline::estimateMilliamps(const uint32_t *words, uint32_t count) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sum += byteSum(words[i]);
+    }
+    return (sum * LED_CHANNEL_MA) / 255 + (count * LED_IDLE_UA) / 1000;
+}
+
+uint16_t ColorPipeline::process(const uint32_t *in, uint32_t *out, uint32_t count, bool &limited) const {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t word = in[i];
+        uint32_t result = (uint32_t)lut[word >> 24] << 24 |
+                          (uint32_t)lut[(word >> 16) & 0xFF] << 16 |
+                          (uint32_t)lut[(word >> 8) & 0xFF] << 8 |
+                          lut[word & 0xFF];
+        out[i] = result;
+        sum += byteSum(result);
+    }
+
+    uint32_t idleMa = (count * LED_IDLE_UA) / 1000;
+    uint32_t activeMa = (sum * LED_CHANNEL_MA) / 255;
+    limited = false;
+    if (budgetMa == 0 || idleMa + activeMa <= budgetMa) {
+        return (uint16_t)(idleMa + activeMa);
+    }
+
+    // Acima do orçamento: escala a parte ativa por budget/estimativa (8.8)
+    uint32_t available = (budgetMa > idleMa) ? budgetMa - idleMa : 0;
+    uint32_t scale = (available << 8) / activeMa;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t word = out[i];
+        out[i] = (((word >> 24) * scale) >> 8) << 24 |
+                 ((((word >> 16) & 0xFF) * scale) >> 8) << 16 |
+                 ((((word >> 8) & 0xFF) * scale) >> 8) << 8 |
+                 (((word & 0xFF) * scale) >> 8);
+    }
+    limited = true;
+    return (uint16_t)estimateMilliamps(out, count);
+}
@@ -0,0 +1,70 @@
+#ifndef COLOR_PIPELINE_HPP
+#define COLOR_PIPELINE_HPP
+
+#include <stdint.h>
+
+// Corrente de um canal WS2812B aceso em 255 e consumo de um LED apagado
+#define LED_CHANNEL_MA 20
+#define LED_IDLE_UA 600
+
+// Tabela gama 2,2 de 8 bits, calculada em tempo de compilação
+struct GammaTable {
+    uint8_t values[256];
+
+    // x^0,2 por Newton (raiz quinta), só usado na compilação
+    static constexpr double fifthRoot(double x) {
+        double y = 1.0;
+        for (int i = 0; i < 60; i++) {
+            double y4 = y * y * y * y;
+            y -= (y4 * y - x) / (5.0 * y4);
+        }
+        return y;
+    }
+
+    static constexpr GammaTable build() {
+        GammaTable table = {};
+        for (int i = 0; i < 256; i++) {
+            double x = i / 255.0;
+            double value = 255.0 * x * x * fifthRoot(x);
+            table.values[i] = (uint8_t)(value + 0.5);
+        }
+        return table;
+    }
+};
+
+extern const GammaTable GAMMA_TABLE;
+
+// Pós-processamento do quadro ao copiar para o buffer de envio: gama e
+// brilho global numa única tabela de 256 bytes, aplicada byte a byte na
+// palavra já codificada (todos os bytes são canais, ou zero). Depois
+// estima a corrente do quadro e, se passar do orçamento, escala tudo em
+// ponto fixo 8.8. Sem ponto flutuante em tempo de execução.
+class ColorPipeline {
+public:
+    ColorPipeline();
+
+    // Brilho perceptual (0-255), aplicado antes da curva gama
+    void setBrightness(uint8_t value);
+    uint8_t brightness() const { return level; }
+    void setGammaEnabled(bool enabled);
+    // Orçamento de corrente da fita em mA; 0 = sem limite
+    void setPowerBudget(uint16_t milliamps) { budgetMa = milliamps; }
+    uint16_t powerBudget() const { return budgetMa; }
+
+    // Processa 'count' palavras de 'in' para 'out'. Retorna a corrente
+    // estimada do quadro enviado, em mA; 'limited' indica se foi escalado.
+    uint16_t process(const uint32_t *in, uint32_t *out, uint32_t count, bool &limited) const;
+
+    // Corrente estimada de 'count' palavras já processadas
+    static uint32_t estimateMilliamps(const uint32_t *words, uint32_t count);
+
+private:
+    uint8_t lut[256];
+    uint8_t level;
+    bool gammaEnabled;
+    uint16_t budgetMa;
+
+    void rebuild();
+};
+
+#endif // COLOR_PIPELINE_HPP
@@ -0,0 +1,287 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "EngineProtocol.hpp"
+#include "SolvedTable.hpp"
+#include "Hal.hpp"
+
+// Resposta de go, igual para os três motores
+typedef struct {
+    int8_t move;
+    uint8_t depth;
+    int32_t score;
+    uint32_t nodes;
+    uint32_t timeUs;
+} EngineReply;
+
+// Separa as palavras no próprio texto; retorna ENGINE_MAX_TOKENS + 1 se sobrou texto
+static uint8_t splitWords(char *text, char **words) {
+    uint8_t count = 0;
+    while (*text) {
+        while (*text == ' ' || *text == '\t') *text++ = '\0';
+        if (!*text) break;
+        if (count == ENGINE_MAX_TOKENS) return ENGINE_MAX_TOKENS + 1;
+        words[count++] = text;
+        while (*text && *text != ' ' && *text != '\t') text++;
+    }
+    return count;
+}
+
+// Só dígitos, sem estourar 32 bits
+static bool parseNumber(const char *text, uint32_t &value) {
+    value = 0;
+    if (!*text) return false;
+    for (; *text; text++) {
+        if (*text < '0' || *text > '9' || value > 429496728) return false;
+        value = value * 10 + (*text - '0');
+    }
+    return true;
+}
+
+// Sorteio entre as jogadas ótimas, como makeAIMove
+static int8_t pickMove(uint16_t mask) {
+    if (mask == 0) return -1;
+    uint8_t choice = rand() % __builtin_popcount(mask);
+    while (choice--) mask &= mask - 1;
+    return (int8_t)__builtin_ctz(mask);
+}
+
+template <uint8_t N, uint8_t K>
+static void searchGrid(GridEngine<N, K> &engine, uint8_t player, uint32_t budgetUs, EngineReply &reply) {
+    GridSearchResult result;
+    engine.search(player, budgetUs, result);
+    reply.move = result.move;
+    reply.depth = result.depth;
+    reply.score = result.score;
+    reply.nodes = result.nodes;
+    reply.timeUs = result.timeUs;
+}
+
+EngineProtocol::EngineProtocol()
+    : lineLength(0), overflow(false), quit(false), variant(ENGINE_3X3), searchKind(ENGINE_TABLE), moveCount(0),
+      positionRevision(0)
+{
+    srand(halTimeMs());
+    newGame();
+}
+
+bool EngineProtocol::poll(uint16_t maxBytes) {
+    int c;
+    for (uint16_t i = 0; i < maxBytes && (c = halConsoleRead()) >= 0; i++) {
+        // Uma linha por chamada: o laço volta a desenhar antes da próxima
+        if (feed((char)c)) return true;
+    }
+    return false;
+}
+
+bool EngineProtocol::feed(char c) {
+    if (c == '\n' || c == '\r') {
+        if (overflow) {
+            overflow = false;
+            lineLength = 0;
+            printf("info string erro: linha com mais de %u caracteres\n", ENGINE_LINE_MAX);
+            fflush(stdout);
+            return true;
+        }
+        // "\r\n": a segunda metade é uma linha vazia
+        if (lineLength == 0) return false;
+        line[lineLength] = '\0';
+        lineLength = 0;
+        handleLine(line);
+        return true;
+    }
+    if (overflow) return false;
+    if (lineLength == ENGINE_LINE_MAX) {
+        overflow = true;
+        return false;
+    }
+    line[lineLength++] = c;
+    return false;
+}
+
+void EngineProtocol::handleLine(char *text) {
+    char *tokens[ENGINE_MAX_TOKENS];
+    uint8_t count = splitWords(text, tokens);
+    if (count == 0) return;
+
+    if (count > ENGINE_MAX_TOKENS) {
+        printf("info string erro: mais de %u palavras\n", ENGINE_MAX_TOKENS);
+    } else if (strcmp(tokens[0], "uci") == 0) {
+        printf("id name TicTacToe BitDogLab\n"
+               "option name Variant type combo default 3x3 var 3x3 var 4x4 var 5x5\n"
+               "option name Engine type combo default table var table var negamax\n"
+               "uciok\n");
+    } else if (strcmp(tokens[0], "isready") == 0) {
+        printf("readyok\n");
+    } else if (strcmp(tokens[0], "ucinewgame") == 0) {
+        newGame();
+    } else if (strcmp(tokens[0], "setoption") == 0) {
+        setOption(tokens, count);
+    } else if (strcmp(tokens[0], "position") == 0) {
+        setPosition(tokens, count);
+    } else if (strcmp(tokens[0], "go") == 0) {
+        go(tokens, count);
+    } else if (strcmp(tokens[0], "d") == 0) {
+        printBoard();
+    } else if (strcmp(tokens[0], "quit") == 0) {
+        quit = true;
+    } else {
+        printf("info string erro: comando desconhecido '%s'\n", tokens[0]);
+    }
+    fflush(stdout);
+}
+
+uint8_t EngineProtocol::boardSize() const {
+    return variant == ENGINE_3X3 ? 3 : variant == ENGINE_4X4 ? 4 : 5;
+}
+
+uint8_t EngineProtocol::cellCount() const {
+    return boardSize() * boardSize();
+}
+
+uint8_t EngineProtocol::cell(uint8_t index) const {
+    switch (variant) {
+        case ENGINE_3X3: return board.get(index);
+        case ENGINE_4X4: return grid4.get(index);
+        default: return grid5.get(index);
+    }
+}
+
+uint8_t EngineProtocol::winner() const {
+    switch (variant) {
+        case ENGINE_3X3: return board.checkWin(1) ? 1 : board.checkWin(2) ? 2 : 0;
+        case ENGINE_4X4: return grid4.winner();
+        default: return grid5.winner();
+    }
+}
+
+void EngineProtocol::newGame() {
+    clearBoard();
+    ai.clearTable();
+}
+
+void EngineProtocol::clearBoard() {
+    board.clear();
+    grid4.clear();
+    grid5.clear();
+    moveCount = 0;
+    positionRevision++;
+}
+
+// Casa vazia com a partida em andamento; a vez sai da contagem de jogadas
+bool EngineProtocol::play(uint8_t index) {
+    if (index >= cellCount() || cell(index) != 0 || winner() != 0) return false;
+    uint8_t player = (moveCount % 2) ? 2 : 1;
+    switch (variant) {
+        case ENGINE_3X3: board.makeMove(index, player); break;
+        case ENGINE_4X4: grid4.makeMove(index, player); break;
+        default: grid5.makeMove(index, player); break;
+    }
+    moves[moveCount++] = index;
+    positionRevision++;
+    return true;
+}
+
+// Jogada inválida no meio: volta à posição anterior
+bool EngineProtocol::setPosition(char **tokens, uint8_t count) {
+    if (count < 2 || strcmp(tokens[1], "startpos") != 0 || (count > 2 && strcmp(tokens[2], "moves") != 0)) {
+        printf("info string erro: use position startpos [moves ...]\n");
+        return false;
+    }
+
+    uint8_t previous[ENGINE_MAX_CELLS];
+    uint8_t previousCount = moveCount;
+    memcpy(previous, moves, moveCount);
+    clearBoard();
+    for (uint8_t i = 3; i < count; i++) {
+        uint32_t index;
+        if (parseNumber(tokens[i], index) && index < cellCount() && play((uint8_t)index)) continue;
+        printf("info string erro: jogada '%s' inválida\n", tokens[i]);
+        clearBoard();
+        for (uint8_t j = 0; j < previousCount; j++) play(previous[j]);
+        return false;
+    }
+    return true;
+}
+
+void EngineProtocol::setOption(char **tokens, uint8_t count) {
+    if (count != 5 || strcmp(tokens[1], "name") != 0 || strcmp(tokens[3], "value") != 0) {
+        printf("info string erro: use setoption name <opção> value <valor>\n");
+        return;
+    }
+    const char *value = tokens[4];
+    if (strcasecmp(tokens[2], "Variant") == 0) {
+        if (strcmp(value, "3x3") == 0) variant = ENGINE_3X3;
+        else if (strcmp(value, "4x4") == 0) variant = ENGINE_4X4;
+        else if (strcmp(value, "5x5") == 0) variant = ENGINE_5X5;
+        else {
+            printf("info string erro: variante '%s' desconhecida\n", value);
+            return;
+        }
+        newGame();
+    } else if (strcasecmp(tokens[2], "Engine") == 0) {
+        if (strcmp(value, "table") == 0) searchKind = ENGINE_TABLE;
+        else if (strcmp(value, "negamax") == 0) searchKind = ENGINE_NEGAMAX;
+        else printf("info string erro: motor '%s' desconhecido\n", value);
+    } else {
+        printf("info string erro: opção '%s' desconhecida\n", tokens[2]);
+    }
+}
+
+// A 3x3 é resolvida em microssegundos e ignora movetime; nas outras
+// movetime é o orçamento do aprofundamento iterativo
+void EngineProtocol::go(char **tokens, uint8_t count) {
+    uint32_t movetimeMs = ENGINE_DEFAULT_MOVETIME_MS;
+    for (uint8_t i = 1; i + 1 < count; i++) {
+        if (strcmp(tokens[i], "movetime") == 0 && !parseNumber(tokens[i + 1], movetimeMs)) {
+            printf("info string erro: movetime '%s' inválido\n", tokens[i + 1]);
+            return;
+        }
+    }
+    if (movetimeMs > ENGINE_MAX_MOVETIME_MS) movetimeMs = ENGINE_MAX_MOVETIME_MS;
+
+    if (winner() != 0 || moveCount == cellCount()) {
+        printf("bestmove none\n");
+        return;
+    }
+
+    uint8_t player = (moveCount % 2) ? 2 : 1;
+    EngineReply reply = {-1, (uint8_t)(cellCount() - moveCount), 0, 0, 0};
+    if (variant == ENGINE_3X3 && searchKind == ENGINE_TABLE) {
+        uint64_t start = halTimeUs();
+        uint16_t entry = solvedLookup(board);
+        reply.move = pickMove(solvedBestMoves(entry));
+        reply.score = solvedScore(entry);
+        reply.nodes = 1;
+        reply.timeUs = (uint32_t)(halTimeUs() - start);
+    } else if (variant == ENGINE_3X3) {
+        SearchResult result;
+        ai.search(board, player, result);
+        reply.move = pickMove(result.bestMoves);
+        reply.score = result.score;
+        reply.nodes = result.nodes;
+        reply.timeUs = result.timeUs;
+    } else if (variant == ENGINE_4X4) {
+        searchGrid(grid4, player, movetimeMs * 1000, reply);
+    } else {
+        searchGrid(grid5, player, movetimeMs * 1000, reply);
+    }
+
+    printf("info depth %u score %ld nodes %lu time %lu timeus %lu nps %lu\n", reply.depth, (long)reply.score,
+           (unsigned long)reply.nodes, (unsigned long)(reply.timeUs / 1000), (unsigned long)reply.timeUs,
+           (unsigned long)(reply.timeUs ? (uint64_t)reply.nodes * 1000000 / reply.timeUs : 0));
+    if (reply.move < 0) printf("bestmove none\n");
+    else printf("bestmove %d\n", reply.move);
+}
+
+void EngineProtocol::printBoard() const {
+    static const char SYMBOLS[3] = {'.', 'x', 'o'};
+    uint8_t size = boardSize();
+    for (uint8_t y = 0; y < size; y++) {
+        for (uint8_t x = 0; x < size; x++) printf("%c ", SYMBOLS[cell(y * size + x)]);
+        printf("\n");
+    }
+    printf("jogadas %u, vez de %c, vencedor %c\n", moveCount, SYMBOLS[(moveCount % 2) ? 2 : 1],
+           SYMBOLS[winner()]);
+}
@@ -0,0 +1,89 @@
+#ifndef ENGINE_PROTOCOL_HPP
+#define ENGINE_PROTOCOL_HPP
+
+#include <stdint.h>
+#include "BitBoard.hpp"
+#include "TicTacToeAI.hpp"
+#include "GridEngine.hpp"
+
+#define ENGINE_LINE_MAX 128             // linha mais longa aceita, sem o fim de linha
+#define ENGINE_MAX_TOKENS 40
+#define ENGINE_MAX_CELLS 25
+#define ENGINE_DEFAULT_MOVETIME_MS 300  // go sem movetime: mesmo tempo da IA do jogo
+#define ENGINE_MAX_MOVETIME_MS 10000
+
+// Variantes que o protocolo joga, com os motores dos modos de jogo
+typedef enum : uint8_t {
+    ENGINE_3X3 = 0,                     // tabela resolvida ou negamax (TicTacToe)
+    ENGINE_4X4,                         // GridEngine<4, 3> (TicTacToeGrid)
+    ENGINE_5X5                          // GridEngine<5, 4>
+} EngineVariant;
+
+// Motor da 3x3: a tabela é a IA do jogo clássico, o negamax conta nós
+typedef enum : uint8_t {
+    ENGINE_TABLE = 0,
+    ENGINE_NEGAMAX
+} EngineSearch;
+
+// Protocolo de motor em texto, uma linha por comando, no estilo UCI, para
+// um programa no computador jogar contra a IA ou medi-la no hardware:
+//   uci                                  id, opções e uciok
+//   isready                              readyok
+//   ucinewgame                           posição inicial, tabelas limpas
+//   setoption name Variant value 3x3|4x4|5x5
+//   setoption name Engine value table|negamax
+//   position startpos [moves c1 c2 ...]  casas y * N + x; o jogador 1 começa
+//   go [movetime ms]                     info ... e bestmove <casa>|none
+//   d                                    tabuleiro em texto
+//   quit
+// Respostas pelo stdout (USB no Pico). Nada é alocado: a linha fica num
+// buffer fixo, é separada em palavras no próprio buffer e uma linha longa
+// demais é descartada até o fim de linha. Tratar uma linha custa no máximo
+// ENGINE_LINE_MAX caracteres mais a busca, limitada por movetime, então
+// poll() cabe num laço de jogo.
+class EngineProtocol {
+public:
+    EngineProtocol();
+
+    // Lê até 'maxBytes' caracteres do stdio; true se alguma linha foi tratada
+    bool poll(uint16_t maxBytes);
+    // Um caractere; true quando fecha uma linha (já tratada)
+    bool feed(char c);
+    // Trata uma linha sem o fim de linha; o texto é alterado no lugar
+    void handleLine(char *line);
+
+    bool quitRequested() const { return quit; }
+    // Muda a cada posição nova, para quem desenha o tabuleiro
+    uint32_t revision() const { return positionRevision; }
+    uint8_t boardSize() const;
+    // 0 = vazia, 1 = quem começou, 2 = o outro
+    uint8_t cell(uint8_t index) const;
+
+private:
+    char line[ENGINE_LINE_MAX + 1];
+    uint16_t lineLength;
+    bool overflow;                      // descartando até o fim da linha
+    bool quit;
+    EngineVariant variant;
+    EngineSearch searchKind;
+    uint8_t moves[ENGINE_MAX_CELLS];
+    uint8_t moveCount;
+    uint32_t positionRevision;
+
+    BitBoard board;
+    TicTacToeAI ai;
+    GridEngine<4, 3> grid4;
+    GridEngine<5, 4> grid5;
+
+    void newGame();
+    void clearBoard();
+    uint8_t cellCount() const;
+    uint8_t winner() const;
+    bool play(uint8_t cell);
+    bool setPosition(char **tokens, uint8_t count);
+    void setOption(char **tokens, uint8_t count);
+    void go(char **tokens, uint8_t count);
+    void printBoard() const;
+};
+
+#endif // ENGINE_PROTOCOL_HPP
@@ -0,0 +1,86 @@
+#include <stdio.h>
+#include <atomic>
+#include "EventLog.hpp"
+#include "Hal.hpp"
+
+static_assert((LOG_RING_RECORDS & (LOG_RING_RECORDS - 1)) == 0, "o anel deve ter tamanho potência de 2");
+static_assert(sizeof(LogRecord) == 16, "registro deve ter 16 bytes");
+
+static LogRecord ring[LOG_RING_RECORDS];
+// head só é escrito pelo produtor, tail só pelo consumidor
+static std::atomic<uint32_t> head(0);
+static std::atomic<uint32_t> tail(0);
+static std::atomic<uint32_t> dropped(0);
+static uint16_t sequence = 0;
+static uint32_t droppedReported = 0;
+
+void logEvent(LogEvent event, int32_t arg0, int32_t arg1) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint16_t seq = sequence++;
+    if (h - tail.load(std::memory_order_acquire) >= LOG_RING_RECORDS) {
+        dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    LogRecord &record = ring[h & (LOG_RING_RECORDS - 1)];
+    record.timeUs = (uint32_t)halTimeUs();
+    record.event = event;
+    record.sequence = seq;
+    record.args[0] = arg0;
+    record.args[1] = arg1;
+    head.store(h + 1, std::memory_order_release);
+}
+
+static void writeHex(char *out, uint32_t value, int digits) {
+    static const char HEX[] = "0123456789abcdef";
+    for (int i = digits - 1; i >= 0; i--) {
+        out[i] = HEX[value & 0xF];
+        value >>= 4;
+    }
+}
+
+// Campos em big-endian, na ordem da estrutura
+static void writeRecord(const LogRecord &record) {
+    char line[2 + 32 + 2];
+    line[0] = '@';
+    line[1] = 'L';
+    writeHex(line + 2, record.timeUs, 8);
+    writeHex(line + 10, record.event, 4);
+    writeHex(line + 14, record.sequence, 4);
+    writeHex(line + 18, (uint32_t)record.args[0], 8);
+    writeHex(line + 26, (uint32_t)record.args[1], 8);
+    line[34] = '\n';
+    line[35] = '\0';
+    fputs(line, stdout);
+}
+
+uint32_t logFlush(uint32_t maxRecords) {
+    uint32_t sent = 0;
+
+    // Descartes são avisados pelo consumidor, para o produtor continuar único
+    uint32_t lost = dropped.load(std::memory_order_relaxed);
+    if (lost != droppedReported && maxRecords > 0) {
+        LogRecord record = {(uint32_t)halTimeUs(), LOG_DROPPED, 0, {(int32_t)(lost - droppedReported), 0}};
+        writeRecord(record);
+        droppedReported = lost;
+        sent++;
+    }
+
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+    while (t != h && sent < maxRecords) {
+        writeRecord(ring[t & (LOG_RING_RECORDS - 1)]);
+        t++;
+        sent++;
+        tail.store(t, std::memory_order_release);
+    }
+    if (sent) fflush(stdout);
+    return sent;
+}
+
+uint32_t logPending() {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+uint32_t logDropped() {
+    return dropped.load(std::memory_order_relaxed);
+}
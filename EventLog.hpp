@@ -0,0 +1,40 @@
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include <stdint.h>
+
+#define LOG_RING_RECORDS 64     // potência de 2
+#define LOG_FLUSH_MAX 4         // registros enviados ao stdio por passada
+
+// Eventos do log. O comentário de cada um é o formato (printf, com os dois
+// argumentos) que host/log_decode.py usa para decodificar; mantenha-os
+// em uma linha e só acrescente ids novos no fim.
+typedef enum : uint16_t {
+    LOG_DROPPED = 0,            // "Log: %d registros descartados"
+    LOG_CLAP_ONSET = 1,         // "Batida detectada em %d ms"
+    LOG_CLAP_GESTURE = 2,       // "Gesto de %d palmas iniciado em %d ms"
+    LOG_AI_VALUE = 3,           // "IA: valor %d"
+    LOG_ANIMATION_LATENCY = 4,  // "Animação: pior latência entrada->LED %d us (%d amostras)"
+    LOG_GAME_STORED = 5,        // "Partida %d gravada na flash (setor %d)"
+    LOG_GAME_DROPPED = 6,       // "Partida %d descartada: fila da flash cheia"
+} LogEvent;
+
+// Registro binário de 16 bytes, enviado como "@L" + 32 dígitos hexa
+typedef struct {
+    uint32_t timeUs;            // 32 bits baixos de halTimeUs()
+    uint16_t event;
+    uint16_t sequence;          // lacunas indicam registros descartados
+    int32_t args[2];
+} LogRecord;
+
+// Anel sem trava com um produtor (o laço do jogo) e um consumidor
+// (logFlush). Gravar custa uma cópia de 16 bytes; com o anel cheio o
+// registro é descartado e contado, nunca bloqueia. logFlush deve ser
+// chamado no fim da passada, quando o trabalho do jogo já terminou.
+void logEvent(LogEvent event, int32_t arg0 = 0, int32_t arg1 = 0);
+// Envia até 'maxRecords' registros; retorna quantos enviou
+uint32_t logFlush(uint32_t maxRecords = LOG_FLUSH_MAX);
+uint32_t logPending();
+uint32_t logDropped();
+
+#endif // EVENT_LOG_HPP
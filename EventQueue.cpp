@@ -0,0 +1,40 @@
+#include <atomic>
+#include "EventQueue.hpp"
+
+static_assert((EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) == 0, "a fila deve ter tamanho potência de 2");
+
+static Event queue[EVENT_QUEUE_SIZE];
+// head só é escrito pelas interrupções, tail só pelo laço
+static std::atomic<uint32_t> head(0);
+static std::atomic<uint32_t> tail(0);
+static uint32_t dropped = 0;
+
+bool eventPost(EventType type, uint8_t source, uint32_t timeUs) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= EVENT_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+    Event &event = queue[h & (EVENT_QUEUE_SIZE - 1)];
+    event.timeUs = timeUs;
+    event.type = type;
+    event.source = source;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+bool eventPop(Event &event) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    event = queue[t & (EVENT_QUEUE_SIZE - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool eventPending() {
+    return tail.load(std::memory_order_relaxed) != head.load(std::memory_order_acquire);
+}
+
+uint32_t eventDropped() {
+    return dropped;
+}
@@ -0,0 +1,41 @@
+#ifndef EVENT_QUEUE_HPP
+#define EVENT_QUEUE_HPP
+
+#include <stdint.h>
+
+#define EVENT_QUEUE_SIZE 32     // potência de 2
+#define EVENT_TIMER_SLOTS 7     // alarmes da HAL (ids 0..6)
+
+// Ids dos alarmes, compartilhados pela camada de entrada e pelos jogos
+#define TIMER_INPUT 0           // varredura dos eixos do joystick
+#define TIMER_MIC 1             // blocos do microfone
+#define TIMER_HOLD 2            // botão B segurado (troca de modo)
+#define TIMER_FRAME 3           // quadros de animação
+#define TIMER_AI 4              // vez da IA (passos do replay)
+#define TIMER_STORAGE 5         // gravação das partidas na flash
+#define TIMER_STRIP 6           // nova tentativa de show() em fita ocupada (várias placas)
+
+typedef enum : uint8_t {
+    EVENT_NONE = 0,
+    EVENT_GPIO_FALL,            // borda de descida (botão pressionado); source = pino
+    EVENT_GPIO_RISE,            // borda de subida (botão solto); source = pino
+    EVENT_TIMER,                // alarme da HAL; source = id
+    EVENT_ADC_READY             // bloco de amostras do ADC pronto; source = id do alarme
+} EventType;
+
+typedef struct {
+    uint32_t timeUs;            // 32 bits baixos de halTimeUs() no instante da interrupção
+    uint8_t type;
+    uint8_t source;
+} Event;
+
+// Fila das interrupções para o laço do jogo. No Pico as interrupções de
+// GPIO e de alarme têm a mesma prioridade e não se interrompem, então há
+// um produtor por vez e o laço é o único consumidor: basta um anel sem
+// trava. Com a fila cheia o evento é descartado e contado.
+bool eventPost(EventType type, uint8_t source, uint32_t timeUs);
+bool eventPop(Event &event);
+bool eventPending();
+uint32_t eventDropped();
+
+#endif // EVENT_QUEUE_HPP
@@ -0,0 +1,124 @@
+#include "FrameBuffer.hpp"
+
+// Glifo 3x5 a partir das linhas em texto ("111" "101" ...): linha 0 nos
+// bits 14-12, coluna 0 no bit mais alto de cada linha
+static constexpr uint16_t glyph(const char* rows) {
+    uint16_t bits = 0;
+    for (uint8_t i = 0; i < FrameBuffer::GLYPH_WIDTH * FrameBuffer::GLYPH_HEIGHT; i++)
+        bits = (uint16_t)(bits << 1) | (rows[i] == '1');
+    return bits;
+}
+
+// Dígitos, A-Z e depois os sinais de FONT_SYMBOLS
+static const char FONT_SYMBOLS[] = " -?:!";
+static constexpr uint16_t FONT[] = {
+    glyph("111" "101" "101" "101" "111"), glyph("010" "110" "010" "010" "111"),
+    glyph("111" "001" "111" "100" "111"), glyph("111" "001" "111" "001" "111"),
+    glyph("101" "101" "111" "001" "001"), glyph("111" "100" "111" "001" "111"),
+    glyph("111" "100" "111" "101" "111"), glyph("111" "001" "001" "010" "010"),
+    glyph("111" "101" "111" "101" "111"), glyph("111" "101" "111" "001" "111"),
+    glyph("010" "101" "111" "101" "101"), glyph("110" "101" "110" "101" "110"),  // A B
+    glyph("011" "100" "100" "100" "011"), glyph("110" "101" "101" "101" "110"),  // C D
+    glyph("111" "100" "110" "100" "111"), glyph("111" "100" "110" "100" "100"),  // E F
+    glyph("011" "100" "101" "101" "011"), glyph("101" "101" "111" "101" "101"),  // G H
+    glyph("111" "010" "010" "010" "111"), glyph("001" "001" "001" "101" "010"),  // I J
+    glyph("101" "101" "110" "101" "101"), glyph("100" "100" "100" "100" "111"),  // K L
+    glyph("101" "111" "111" "101" "101"), glyph("110" "101" "101" "101" "101"),  // M N
+    glyph("010" "101" "101" "101" "010"), glyph("110" "101" "110" "100" "100"),  // O P
+    glyph("010" "101" "101" "110" "011"), glyph("110" "101" "110" "101" "101"),  // Q R
+    glyph("011" "100" "010" "001" "110"), glyph("111" "010" "010" "010" "010"),  // S T
+    glyph("101" "101" "101" "101" "111"), glyph("101" "101" "101" "101" "010"),  // U V
+    glyph("101" "101" "111" "111" "101"), glyph("101" "101" "010" "101" "101"),  // W X
+    glyph("101" "101" "010" "010" "010"), glyph("111" "001" "010" "100" "111"),  // Y Z
+    glyph("000" "000" "000" "000" "000"), glyph("000" "000" "111" "000" "000"),  // espaço -
+    glyph("111" "001" "010" "000" "010"), glyph("000" "010" "000" "010" "000"),  // ? :
+    glyph("010" "010" "010" "000" "010")                                          // !
+};
+#define FONT_LETTERS 10
+#define FONT_SYMBOL_FIRST 36
+#define FONT_UNKNOWN (FONT_SYMBOL_FIRST + 2)
+static_assert(sizeof(FONT) / sizeof(FONT[0]) == FONT_SYMBOL_FIRST + sizeof(FONT_SYMBOLS) - 1, "fonte incompleta");
+
+static uint8_t glyphIndex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+    if (c >= 'A' && c <= 'Z') return FONT_LETTERS + (c - 'A');
+    for (uint8_t i = 0; FONT_SYMBOLS[i]; i++)
+        if (FONT_SYMBOLS[i] == c) return FONT_SYMBOL_FIRST + i;
+    return FONT_UNKNOWN;
+}
+
+FrameBuffer::FrameBuffer(WS2812Base& strip, const MatrixGeometry& geometry)
+    : strip(strip), geometry(geometry), originX(0), originY(0)
+{
+}
+
+void FrameBuffer::setOrigin(int16_t x, int16_t y) {
+    originX = x;
+    originY = y;
+}
+
+void FrameBuffer::centerArea(uint8_t w, uint8_t h) {
+    setOrigin((geometry.width - w) / 2, (geometry.height - h) / 2);
+}
+
+int16_t FrameBuffer::index(int16_t x, int16_t y) const {
+    x += originX;
+    y += originY;
+    if (x < 0 || y < 0 || x >= geometry.width || y >= geometry.height) return -1;
+    return geometry.indices[y * geometry.width + x];
+}
+
+void FrameBuffer::clear(Color color) {
+    strip.fill(color);
+}
+
+void FrameBuffer::setPixel(int16_t x, int16_t y, Color color) {
+    int16_t led = index(x, y);
+    if (led >= 0) strip.setPixelColor(led, color);
+}
+
+// Recorta uma vez e percorre a tabela linha a linha
+void FrameBuffer::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color) {
+    int16_t x0 = x + originX, y0 = y + originY;
+    int16_t x1 = x0 + w, y1 = y0 + h;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > geometry.width) x1 = geometry.width;
+    if (y1 > geometry.height) y1 = geometry.height;
+    for (int16_t row = y0; row < y1; row++) {
+        const uint16_t* indices = geometry.indices + row * geometry.width;
+        for (int16_t column = x0; column < x1; column++)
+            strip.setPixelColor(indices[column], color);
+    }
+}
+
+void FrameBuffer::blit(const Sprite& sprite, int16_t x, int16_t y) {
+    for (uint8_t row = 0; row < sprite.height; row++) {
+        int16_t py = y + row + originY;
+        if (py < 0 || py >= geometry.height) continue;
+        const uint8_t* pixels = sprite.pixels + row * sprite.width;
+        const uint16_t* indices = geometry.indices + py * geometry.width;
+        for (uint8_t column = 0; column < sprite.width; column++) {
+            int16_t px = x + column + originX;
+            uint8_t value = pixels[column];
+            if (value == 0 || px < 0 || px >= geometry.width) continue;
+            strip.setPixelColor(indices[px], sprite.palette[value - 1]);
+        }
+    }
+}
+
+uint8_t FrameBuffer::drawGlyph(char c, int16_t x, int16_t y, Color color) {
+    uint16_t bits = FONT[glyphIndex(c)];
+    for (uint8_t row = 0; row < GLYPH_HEIGHT; row++) {
+        for (uint8_t column = 0; column < GLYPH_WIDTH; column++) {
+            if (bits & (1u << (14 - row * GLYPH_WIDTH - column))) setPixel(x + column, y + row, color);
+        }
+    }
+    return GLYPH_WIDTH + 1;
+}
+
+int16_t FrameBuffer::drawText(const char* text, int16_t x, int16_t y, Color color) {
+    while (*text) x += drawGlyph(*text++, x, y, color);
+    return x;
+}
@@ -0,0 +1,58 @@
+#ifndef FRAME_BUFFER_HPP
+#define FRAME_BUFFER_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+#include "MatrixGeometry.hpp"
+
+// Sprite com paleta: um byte por pixel, linha a linha; 0 = transparente,
+// n = palette[n - 1]
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint8_t *pixels;
+    const WS2812Base::Color *palette;
+} Sprite;
+
+// Desenho em coordenadas (x, y) do painel direto no buffer da fita, pela
+// tabela de índices da geometria: a ordem do fio (linhas, serpentina, giro)
+// não custa nada por pixel. Tudo que sai do painel é recortado. O envio
+// continua sendo show() da fita.
+class FrameBuffer {
+public:
+    typedef WS2812Base::Color Color;
+
+    static const uint8_t GLYPH_WIDTH = 3;
+    static const uint8_t GLYPH_HEIGHT = 5;
+
+    FrameBuffer(WS2812Base& strip, const MatrixGeometry& geometry = PanelLayout::geometry());
+
+    uint8_t width() const { return geometry.width; }
+    uint8_t height() const { return geometry.height; }
+
+    // Desloca todo o desenho; centerArea() põe uma área w x h no meio do painel
+    void setOrigin(int16_t x, int16_t y);
+    void centerArea(uint8_t w, uint8_t h);
+
+    // Índice no fio de (x, y), já com a origem; -1 fora do painel
+    int16_t index(int16_t x, int16_t y) const;
+
+    void clear(Color color);
+    void setPixel(int16_t x, int16_t y, Color color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, Color color);
+    void blit(const Sprite& sprite, int16_t x, int16_t y);
+
+    // Fonte 3x5: dígitos, A-Z (minúsculas viram maiúsculas), espaço e - ? : !
+    // Outros caracteres saem como '?'. Retorna o avanço (largura + 1)
+    uint8_t drawGlyph(char c, int16_t x, int16_t y, Color color);
+    // Retorna o x depois do último caractere
+    int16_t drawText(const char* text, int16_t x, int16_t y, Color color);
+
+private:
+    WS2812Base& strip;
+    MatrixGeometry geometry;
+    int16_t originX;
+    int16_t originY;
+};
+
+#endif // FRAME_BUFFER_HPP
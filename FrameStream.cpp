@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include "FrameStream.hpp"
+#include "Hal.hpp"
+
+#define STREAM_POLL_US 200          // espera entre leituras quando nada chegou
+
+FrameStream::FrameStream(WS2812& strip, uint32_t targetFps)
+    : strip(strip), periodUs(1000000 / (targetFps ? targetFps : 1)), state(WAIT_SYNC0), received(0),
+      length(0), crc(0xFFFF), frameCrc(0), pixel(0), channels(0), lastByteUs(0), lastFrameUs(0),
+      nextSequence(0), reportFrames(0), reportUs(halTimeUs()), streamStats()
+{
+}
+
+bool FrameStream::poll() {
+    bool any = false;
+    int c;
+    while ((c = halConsoleRead()) >= 0) {
+        any = true;
+        // Quadro mostrado: volta ao laço para a linha de estado não esperar
+        if (feed((uint8_t)c)) break;
+    }
+
+    uint64_t now = halTimeUs();
+    if (any) {
+        lastByteUs = now;
+    } else if (state != WAIT_SYNC0 && now - lastByteUs > STREAM_TIMEOUT_MS * 1000ull) {
+        streamStats.timeouts++;
+        state = WAIT_SYNC0;
+    }
+    return any;
+}
+
+bool FrameStream::feed(uint8_t byte) {
+    streamStats.bytes++;
+    switch (state) {
+        case WAIT_SYNC0:
+            if (byte == STREAM_SYNC0) state = WAIT_SYNC1;
+            return false;
+
+        case WAIT_SYNC1:
+            if (byte == STREAM_SYNC1) {
+                state = HEADER;
+                received = 0;
+                crc = 0xFFFF;
+            } else if (byte != STREAM_SYNC0) {
+                state = WAIT_SYNC0;
+            }
+            return false;
+
+        case HEADER: {
+            header[received++] = byte;
+            crc = crcUpdate(crc, byte);
+            if (received < STREAM_HEADER_BYTES) return false;
+
+            // Só quadros da fita inteira: assim nada do quadro anterior sobra
+            length = header[1] | (uint16_t)header[2] << 8;
+            uint32_t expected = header[0] == STREAM_PIXELS ? strip.ledCount() * 3 :
+                                header[0] == STREAM_STATUS ? 0 : ~0u;
+            if (length != expected) {
+                streamStats.badHeaders++;
+                state = WAIT_SYNC0;
+                return false;
+            }
+            received = 0;
+            pixel = 0;
+            channels = 0;
+            state = length ? PAYLOAD : CHECK;
+            return false;
+        }
+
+        case PAYLOAD:
+            crc = crcUpdate(crc, byte);
+            channels = channels << 8 | byte;
+            if (++received % 3 == 0) {
+                strip.setPixelColor(pixel++, WS2812::color((uint8_t)(channels >> 16), (uint8_t)(channels >> 8),
+                                                           (uint8_t)channels));
+                channels = 0;
+            }
+            if (received == length) {
+                state = CHECK;
+                received = 0;
+            }
+            return false;
+
+        case CHECK:
+            if (received++ == 0) {
+                frameCrc = byte;
+                return false;
+            }
+            frameCrc |= (uint16_t)byte << 8;
+            state = WAIT_SYNC0;
+            if (frameCrc != crc) {
+                streamStats.crcErrors++;
+                return false;
+            }
+            return finishFrame();
+    }
+    return false;
+}
+
+bool FrameStream::finishFrame() {
+    if (header[0] == STREAM_STATUS) {
+        printStatus();
+        return false;
+    }
+
+    uint16_t sequence = header[3] | (uint16_t)header[4] << 8;
+    uint64_t now = halTimeUs();
+    if (streamStats.frames > 0) {
+        // Sequência para trás: o computador recomeçou a contagem
+        uint16_t gap = sequence - nextSequence;
+        if (gap < 0x8000) streamStats.dropped += gap;
+        if (now - lastFrameUs > periodUs + periodUs / 2) streamStats.late++;
+    }
+    nextSequence = sequence + 1;
+    lastFrameUs = now;
+    streamStats.frames++;
+    reportFrames++;
+    strip.show();
+    return true;
+}
+
+void FrameStream::printStatus() {
+    uint64_t now = halTimeUs();
+    double fps = now > reportUs ? reportFrames * 1e6 / (now - reportUs) : 0.0;
+    printf("STREAM quadros=%lu perdidos=%lu atrasados=%lu crc=%lu invalidos=%lu incompletos=%lu bytes=%llu "
+           "fps=%.1f alvo=%lu leds=%u\n",
+           (unsigned long)streamStats.frames, (unsigned long)streamStats.dropped,
+           (unsigned long)streamStats.late, (unsigned long)streamStats.crcErrors,
+           (unsigned long)streamStats.badHeaders, (unsigned long)streamStats.timeouts,
+           (unsigned long long)streamStats.bytes, fps, (unsigned long)(1000000 / periodUs), strip.ledCount());
+    fflush(stdout);
+    reportFrames = 0;
+    reportUs = now;
+}
+
+void FrameStream::run() {
+    printStatus();
+    while (halRunning()) {
+        bool received = poll();
+        if (halTimeUs() - reportUs >= STREAM_REPORT_MS * 1000ull) printStatus();
+        if (!received) halSleepUs(STREAM_POLL_US);
+    }
+    printStatus();
+}
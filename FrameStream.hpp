@@ -0,0 +1,91 @@
+#ifndef FRAME_STREAM_HPP
+#define FRAME_STREAM_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+
+#define STREAM_TARGET_FPS 60        // ritmo esperado do computador
+#define STREAM_REPORT_MS 1000       // intervalo da linha de estado
+#define STREAM_TIMEOUT_MS 100       // quadro parado no meio volta a procurar a sincronia
+
+// Quadro no fio, inteiros em little-endian:
+//   0xA5 0x5A | tipo | tamanho (2) | sequência (2) | dados | CRC (2)
+// CRC-16/CCITT-FALSE de tipo até o fim dos dados
+#define STREAM_SYNC0 0xA5
+#define STREAM_SYNC1 0x5A
+#define STREAM_HEADER_BYTES 5       // tipo, tamanho, sequência
+
+typedef enum : uint8_t {
+    STREAM_PIXELS = 1,              // R, G, B de cada LED na ordem do fio, fita inteira
+    STREAM_STATUS = 2               // sem dados: pede a linha de estado na hora
+} StreamFrameType;
+
+// Contadores desde o início do modo
+typedef struct {
+    uint32_t frames;                // quadros mostrados
+    uint32_t dropped;               // números de sequência que não chegaram a ser mostrados
+    uint32_t late;                  // chegaram mais de 1,5 período depois do anterior
+    uint32_t crcErrors;
+    uint32_t badHeaders;            // tipo ou tamanho inválido
+    uint32_t timeouts;              // quadros interrompidos no meio
+    uint64_t bytes;                 // bytes recebidos, inclusive os descartados
+} StreamStats;
+
+// Modo stream: o computador desenha e manda quadros pelo stdio (USB CDC
+// no Pico, stdin com TICTACTOE_STDIN=1 no simulador). Os dados de cada
+// pixel vão direto para o buffer de desenho da fita, sem buffer de
+// recepção; só um quadro com CRC certo chega a show(). Como o buffer de
+// desenho é sobrescrito por inteiro a cada quadro, um quadro corrompido
+// nunca aparece nos LEDs. A linha de estado sai pelo mesmo stdio:
+//   STREAM quadros=.. perdidos=.. atrasados=.. crc=.. invalidos=.. ...
+class FrameStream {
+public:
+    FrameStream(WS2812& strip, uint32_t targetFps = STREAM_TARGET_FPS);
+
+    // Consome os bytes já recebidos, parando no fim de um quadro mostrado;
+    // true se algum chegou
+    bool poll();
+    // Um byte do fio; true quando fecha um quadro de pixels válido
+    bool feed(uint8_t byte);
+    // poll() e a linha de estado periódica até o fim do simulador
+    void run();
+
+    const StreamStats& stats() const { return streamStats; }
+    void printStatus();
+
+    static uint16_t crcUpdate(uint16_t crc, uint8_t byte) {
+        uint8_t x = (crc >> 8) ^ byte;
+        x ^= x >> 4;
+        return (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+    }
+
+private:
+    typedef enum : uint8_t {
+        WAIT_SYNC0,
+        WAIT_SYNC1,
+        HEADER,
+        PAYLOAD,
+        CHECK
+    } State;
+
+    WS2812& strip;
+    uint32_t periodUs;
+    State state;
+    uint8_t header[STREAM_HEADER_BYTES];
+    uint16_t received;              // bytes do estado atual
+    uint16_t length;
+    uint16_t crc;
+    uint16_t frameCrc;
+    uint32_t pixel;                 // próximo LED e canais já recebidos dele
+    uint32_t channels;
+    uint64_t lastByteUs;
+    uint64_t lastFrameUs;
+    uint16_t nextSequence;
+    uint32_t reportFrames;
+    uint64_t reportUs;
+    StreamStats streamStats;
+
+    bool finishFrame();
+};
+
+#endif // FRAME_STREAM_HPP
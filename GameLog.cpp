@@ -0,0 +1,305 @@
+#include <string.h>
+#include "GameLog.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+
+// Cabeçalho do setor: marca, geração, apagamentos e a geração invertida,
+// gravada por último, que só confere se o cabeçalho inteiro foi gravado
+#define SECTOR_MAGIC 0x474F4C47u   // "GLOG" em little-endian
+#define HEADER_SIZE 16
+
+// Registro: tamanho, confirmação, número (4 bytes), modo/resultado/jogadas,
+// jogadas de 4 bits (a primeira no nibble baixo) e CRC-8 de tudo menos a
+// confirmação, que sai de 0xFF para 0x00 só depois do corpo gravado
+#define RECORD_SIZE_BYTE 0
+#define RECORD_COMMIT_BYTE 1
+#define RECORD_FIXED 8
+#define RECORD_MIN RECORD_FIXED
+#define RECORD_MAX (RECORD_FIXED + (GAME_LOG_MAX_MOVES + 1) / 2)
+#define RECORD_COMMITTED 0x00
+
+static_assert((GAME_LOG_QUEUE & (GAME_LOG_QUEUE - 1)) == 0, "a fila deve ter tamanho potência de 2");
+
+static uint32_t readWord(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void writeWord(uint8_t *bytes, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) bytes[i] = (uint8_t)(value >> (8 * i));
+}
+
+// CRC-8 (polinômio 0x07), pulando o byte de confirmação
+static uint8_t recordCrc(const uint8_t *bytes, uint8_t size) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < size - 1; i++) {
+        if (i == RECORD_COMMIT_BYTE) continue;
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint8_t recordSize(uint8_t moveCount) {
+    return RECORD_FIXED + (moveCount + 1) / 2;
+}
+
+// Registro ainda sem confirmação (0xFF), pronto para gravar
+static uint8_t encodeRecord(const GameRecord &record, uint8_t *bytes) {
+    uint8_t size = recordSize(record.moveCount);
+    memset(bytes, 0, size);
+    bytes[RECORD_SIZE_BYTE] = size;
+    bytes[RECORD_COMMIT_BYTE] = 0xFF;
+    writeWord(bytes + 2, record.sequence);
+    bytes[6] = (record.mode & 0x03) | ((record.result & 0x03) << 2) | (record.moveCount << 4);
+    for (uint8_t i = 0; i < record.moveCount; i++)
+        bytes[7 + i / 2] |= (record.moves[i] & 0x0F) << ((i & 1) * 4);
+    bytes[size - 1] = recordCrc(bytes, size);
+    return size;
+}
+
+// Só registros confirmados e íntegros
+static bool decodeRecord(const uint8_t *bytes, GameRecord &record) {
+    uint8_t size = bytes[RECORD_SIZE_BYTE];
+    if (bytes[RECORD_COMMIT_BYTE] != RECORD_COMMITTED) return false;
+    record.moveCount = bytes[6] >> 4;
+    if (record.moveCount > GAME_LOG_MAX_MOVES || recordSize(record.moveCount) != size) return false;
+    if (recordCrc(bytes, size) != bytes[size - 1]) return false;
+
+    record.sequence = readWord(bytes + 2);
+    record.mode = bytes[6] & 0x03;
+    record.result = (bytes[6] >> 2) & 0x03;
+    for (uint8_t i = 0; i < record.moveCount; i++)
+        record.moves[i] = (bytes[7 + i / 2] >> ((i & 1) * 4)) & 0x0F;
+    return true;
+}
+
+GameLog::GameLog()
+    : regionOffset(0), active(GAME_LOG_SECTORS - 1), writeOffset(HAL_FLASH_SECTOR_SIZE),
+      spareReady(false), bodyWritten(false), nextSequence(1), head(0), tail(0)
+{
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+        sectorSequence[s] = 0;
+        eraseCounts[s] = 0;
+        recordCounts[s] = 0;
+    }
+}
+
+uint32_t GameLog::sectorOffset(uint8_t sector) const {
+    return regionOffset + (uint32_t)sector * HAL_FLASH_SECTOR_SIZE;
+}
+
+void GameLog::mount() {
+    regionOffset = halFlashSize() - GAME_LOG_SECTORS * HAL_FLASH_SECTOR_SIZE;
+    bodyWritten = false;
+
+    uint32_t newest = 0;
+    uint32_t maxErases = 0;
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+        const uint8_t *header = halFlashRead(sectorOffset(s));
+        uint32_t sequence = readWord(header + 4);
+        sectorSequence[s] = 0;
+        recordCounts[s] = 0;
+        if (readWord(header) != SECTOR_MAGIC || readWord(header + 12) != ~sequence || sequence == 0) continue;
+
+        sectorSequence[s] = sequence;
+        eraseCounts[s] = readWord(header + 8);
+        if (eraseCounts[s] > maxErases) maxErases = eraseCounts[s];
+        if (sequence > newest) {
+            newest = sequence;
+            active = s;
+        }
+    }
+
+    // Setores sem cabeçalho perderam a contagem: a maior conhecida é a estimativa
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+        if (sectorSequence[s] == 0) eraseCounts[s] = maxErases;
+    }
+
+    nextSequence = 1;
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+        if (sectorSequence[s] == 0) continue;
+        uint16_t end;
+        uint32_t lastSequence = 0;
+        recordCounts[s] = scanSector(s, -1, nullptr, end, lastSequence);
+        if (lastSequence >= nextSequence) nextSequence = lastSequence + 1;
+        if (s == active) writeOffset = end;
+    }
+
+    // Flash sem log: o último setor faz de ativo cheio, e a primeira
+    // gravação abre o setor 0
+    if (newest == 0) {
+        active = GAME_LOG_SECTORS - 1;
+        writeOffset = HAL_FLASH_SECTOR_SIZE;
+    }
+    spareReady = isBlank(sectorOffset((active + 1) % GAME_LOG_SECTORS), HAL_FLASH_SECTOR_SIZE);
+}
+
+// Percorre os registros do setor: conta os válidos, copia em 'record' o de
+// ordem 'wanted' (se >= 0) e devolve em 'end' onde o próximo seria gravado.
+// Um tamanho impossível encerra o setor: nada mais é gravado nele
+uint16_t GameLog::scanSector(uint8_t sector, int32_t wanted, GameRecord *record,
+                             uint16_t &end, uint32_t &lastSequence) const {
+    const uint8_t *base = halFlashRead(sectorOffset(sector));
+    uint16_t offset = HEADER_SIZE;
+    uint16_t count = 0;
+    while (offset < HAL_FLASH_SECTOR_SIZE) {
+        uint8_t size = base[offset + RECORD_SIZE_BYTE];
+        if (size == 0xFF) break;
+        if (size < RECORD_MIN || size > RECORD_MAX || offset + size > HAL_FLASH_SECTOR_SIZE) {
+            offset = HAL_FLASH_SECTOR_SIZE;
+            break;
+        }
+        GameRecord decoded;
+        if (decodeRecord(base + offset, decoded)) {
+            if ((int32_t)count == wanted && record) *record = decoded;
+            if (decoded.sequence > lastSequence) lastSequence = decoded.sequence;
+            count++;
+        }
+        offset += size;
+    }
+    end = offset;
+    return count;
+}
+
+bool GameLog::isBlank(uint32_t offset, uint32_t length) const {
+    const uint8_t *bytes = halFlashRead(offset);
+    for (uint32_t i = 0; i < length; i++) {
+        if (bytes[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+// Grava bytes soltos: cada página tocada é gravada com 0xFF fora do trecho
+void GameLog::program(uint32_t offset, const uint8_t *data, uint32_t length) {
+    static uint8_t page[HAL_FLASH_PAGE_SIZE];
+    while (length > 0) {
+        uint32_t pageOffset = offset & ~(HAL_FLASH_PAGE_SIZE - 1);
+        uint32_t start = offset - pageOffset;
+        uint32_t chunk = HAL_FLASH_PAGE_SIZE - start;
+        if (chunk > length) chunk = length;
+
+        memset(page, 0xFF, sizeof(page));
+        memcpy(page + start, data, chunk);
+        halFlashProgram(pageOffset, page);
+
+        offset += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+}
+
+// O setor reserva é o mais antigo: as partidas dele se perdem aqui
+void GameLog::eraseSpare() {
+    if (spareReady) return;
+    PROBE_SCOPE(PROBE_FLASH);
+    uint8_t spare = (active + 1) % GAME_LOG_SECTORS;
+    halFlashErase(sectorOffset(spare));
+    eraseCounts[spare]++;
+    sectorSequence[spare] = 0;
+    recordCounts[spare] = 0;
+    spareReady = true;
+}
+
+// Setor ativo cheio: o reserva, já apagado, ganha cabeçalho e vira o ativo
+void GameLog::openSpare() {
+    uint8_t spare = (active + 1) % GAME_LOG_SECTORS;
+    uint32_t sequence = sectorSequence[active] + 1;
+    uint8_t header[HEADER_SIZE];
+    writeWord(header, SECTOR_MAGIC);
+    writeWord(header + 4, sequence);
+    writeWord(header + 8, eraseCounts[spare]);
+    writeWord(header + 12, ~sequence);
+    program(sectorOffset(spare), header, HEADER_SIZE);
+
+    sectorSequence[spare] = sequence;
+    active = spare;
+    writeOffset = HEADER_SIZE;
+    spareReady = false;
+}
+
+bool GameLog::append(GameRecord &record) {
+    if ((uint8_t)(head - tail) >= GAME_LOG_QUEUE) {
+        logEvent(LOG_GAME_DROPPED, nextSequence);
+        return false;
+    }
+    if (record.moveCount > GAME_LOG_MAX_MOVES) record.moveCount = GAME_LOG_MAX_MOVES;
+    record.sequence = nextSequence++;
+    queue[head & (GAME_LOG_QUEUE - 1)] = record;
+    head++;
+    return true;
+}
+
+// Sem espaço no setor ativo, ou restos de uma gravação interrompida
+bool GameLog::needsSector(const GameRecord &record) const {
+    uint8_t size = recordSize(record.moveCount);
+    return writeOffset + size > HAL_FLASH_SECTOR_SIZE || !isBlank(sectorOffset(active) + writeOffset, size);
+}
+
+bool GameLog::busy() const {
+    return head != tail || !spareReady;
+}
+
+bool GameLog::writePending() const {
+    if (head == tail) return false;
+    return bodyWritten || spareReady || !needsSector(queue[tail & (GAME_LOG_QUEUE - 1)]);
+}
+
+void GameLog::service() {
+    if (!writePending()) return;
+    PROBE_SCOPE(PROBE_FLASH);
+
+    const GameRecord &record = queue[tail & (GAME_LOG_QUEUE - 1)];
+    uint8_t bytes[RECORD_MAX];
+    uint8_t size = encodeRecord(record, bytes);
+    uint32_t offset = sectorOffset(active) + writeOffset;
+
+    if (!bodyWritten) {
+        // writePending() garante o reserva apagado quando precisa de outro setor
+        if (needsSector(record)) {
+            openSpare();
+            return;
+        }
+        program(offset, bytes, size);
+        bodyWritten = true;
+        return;
+    }
+
+    uint8_t commit = RECORD_COMMITTED;
+    program(offset + RECORD_COMMIT_BYTE, &commit, 1);
+    bodyWritten = false;
+    writeOffset += size;
+    recordCounts[active]++;
+    tail++;
+    logEvent(LOG_GAME_STORED, record.sequence, active);
+}
+
+uint32_t GameLog::count() const {
+    uint32_t total = 0;
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) total += recordCounts[s];
+    return total;
+}
+
+// Setores do mais novo para o mais antigo; dentro do setor, do fim para o início
+bool GameLog::read(uint32_t index, GameRecord &record) const {
+    uint32_t previous = UINT32_MAX;
+    for (uint8_t pass = 0; pass < GAME_LOG_SECTORS; pass++) {
+        int16_t sector = -1;
+        for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+            if (sectorSequence[s] == 0 || sectorSequence[s] >= previous) continue;
+            if (sector < 0 || sectorSequence[s] > sectorSequence[sector]) sector = s;
+        }
+        if (sector < 0) return false;
+        previous = sectorSequence[sector];
+
+        uint16_t count = recordCounts[sector];
+        if (index < count) {
+            uint16_t end;
+            uint32_t lastSequence = 0;
+            scanSector((uint8_t)sector, count - 1 - index, &record, end, lastSequence);
+            return true;
+        }
+        index -= count;
+    }
+    return false;
+}
@@ -0,0 +1,95 @@
+#ifndef GAME_LOG_HPP
+#define GAME_LOG_HPP
+
+#include <stdint.h>
+#include "Hal.hpp"
+
+#define GAME_LOG_SECTORS 16     // 64 KB no fim da flash
+#define GAME_LOG_QUEUE 4        // partidas esperando gravação (potência de 2)
+#define GAME_LOG_MAX_MOVES 9
+
+typedef enum : uint8_t {
+    GAME_RESULT_DRAW = 0,
+    GAME_RESULT_AI,
+    GAME_RESULT_HUMAN
+} GameResult;
+
+// Partida do jogo clássico: casas (índices do BitBoard) na ordem em que
+// foram jogadas, começando pela IA
+typedef struct {
+    uint32_t sequence;          // número da partida, crescente; dado por append()
+    uint8_t mode;               // InputMode da partida
+    uint8_t result;             // GameResult
+    uint8_t moveCount;
+    uint8_t moves[GAME_LOG_MAX_MOVES];
+} GameRecord;
+
+// Log das partidas num anel de setores no fim da flash. Cada partida vira
+// um registro de 8 a 13 bytes (cabeçalho, jogadas de 4 bits, CRC) gravado
+// em dois passos: o corpo e depois o byte de confirmação, então uma queda
+// de energia no meio deixa um registro sem confirmação que a leitura
+// ignora. Os setores são usados em ordem circular, cada um com o número de
+// geração e a contagem de apagamentos no cabeçalho, o que distribui o
+// desgaste por igual; o setor seguinte ao ativo é apagado com antecedência,
+// para a troca de setor não esperar por um apagamento. Os setores mais
+// antigos são reaproveitados quando o anel enche.
+//
+// append() só copia a partida para uma fila em RAM; a gravação anda em
+// service(), uma página por chamada. No Pico cada operação da flash mascara
+// as interrupções: uma página custa ~0,4 ms (3 ms no pior caso, pela folha
+// de dados da W25Q16), mas apagar um setor custa ~45 ms (até 400 ms). Por
+// isso o apagamento não sai de service(): fica em eraseSpare(), que o jogo
+// só chama entre partidas. Enquanto o reserva não é apagado, uma partida
+// que não cabe no setor ativo espera na fila. PROBE_FLASH mede os dois.
+class GameLog {
+public:
+    GameLog();
+
+    // Lê a região: setor ativo, fim do log e contagem das partidas
+    void mount();
+    // Enfileira a partida e preenche 'sequence'; false se a fila está cheia
+    bool append(GameRecord &record);
+    // No máximo uma gravação de página; nunca apaga. No Pico mascara as
+    // interrupções: chamar quando não há animação tocando
+    void service();
+    // service() tem o que gravar agora
+    bool writePending() const;
+    // O setor reserva ainda precisa ser apagado
+    bool needsErase() const { return !spareReady; }
+    // Apaga o setor reserva: dezenas de ms com as interrupções mascaradas
+    // no Pico, então só entre partidas ou no fim do programa
+    void eraseSpare();
+    // Há gravação pendente ou o setor reserva ainda precisa ser apagado
+    bool busy() const;
+
+    // Partidas guardadas na flash (sem as da fila)
+    uint32_t count() const;
+    // Partida 'index', 0 = mais recente
+    bool read(uint32_t index, GameRecord &record) const;
+    uint32_t eraseCount(uint8_t sector) const { return eraseCounts[sector]; }
+
+private:
+    uint32_t regionOffset;
+    uint32_t sectorSequence[GAME_LOG_SECTORS];   // geração do setor; 0 = sem cabeçalho
+    uint32_t eraseCounts[GAME_LOG_SECTORS];
+    uint16_t recordCounts[GAME_LOG_SECTORS];
+    uint8_t active;
+    uint16_t writeOffset;       // fim do log dentro do setor ativo
+    bool spareReady;            // setor seguinte ao ativo apagado
+    bool bodyWritten;           // corpo do registro da vez gravado, falta confirmar
+    uint32_t nextSequence;
+
+    GameRecord queue[GAME_LOG_QUEUE];
+    uint8_t head;
+    uint8_t tail;
+
+    uint32_t sectorOffset(uint8_t sector) const;
+    uint16_t scanSector(uint8_t sector, int32_t wanted, GameRecord *record,
+                        uint16_t &end, uint32_t &lastSequence) const;
+    bool isBlank(uint32_t offset, uint32_t length) const;
+    void program(uint32_t offset, const uint8_t *data, uint32_t length);
+    bool needsSector(const GameRecord &record) const;
+    void openSpare();
+};
+
+#endif // GAME_LOG_HPP
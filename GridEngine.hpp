@@ -0,0 +1,309 @@
+#ifndef GRID_ENGINE_HPP
+#define GRID_ENGINE_HPP
+
+#include <stdint.h>
+#include "Hal.hpp"
+
+// Resultado da busca com aprofundamento iterativo
+typedef struct {
+    int8_t move;         // melhor jogada da última profundidade completa (-1 se não há)
+    int32_t score;       // valor do ponto de vista de quem joga
+    uint8_t depth;       // última profundidade concluída
+    bool exact;          // a árvore foi esgotada: o valor é o teórico
+    uint32_t nodes;      // nós visitados em todas as iterações
+    uint32_t timeUs;     // duração total
+} GridSearchResult;
+
+// Todas as janelas de K células alinhadas de um tabuleiro N x N, geradas
+// em tempo de compilação, e as janelas que passam por cada célula.
+template <uint8_t N, uint8_t K>
+struct GridLines {
+    static constexpr uint8_t CELL_COUNT = N * N;
+    static constexpr uint8_t WINDOWS = N - K + 1;
+    static constexpr uint16_t LINE_COUNT = 2 * N * WINDOWS + 2 * WINDOWS * WINDOWS;
+    static constexpr uint8_t MAX_LINES_PER_CELL = 4 * K;
+
+    uint8_t cells[LINE_COUNT][K];
+    uint8_t cellLineCount[CELL_COUNT];
+    uint16_t cellLines[CELL_COUNT][MAX_LINES_PER_CELL];
+
+    static constexpr GridLines build() {
+        GridLines lines = {};
+        // Direções: horizontal, vertical, diagonal e antidiagonal
+        const int8_t dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {-1, 1}};
+        uint16_t line = 0;
+        for (uint8_t d = 0; d < 4; d++) {
+            for (int8_t y = 0; y < N; y++) {
+                for (int8_t x = 0; x < N; x++) {
+                    int8_t endX = x + dirs[d][0] * (K - 1);
+                    int8_t endY = y + dirs[d][1] * (K - 1);
+                    if (endX < 0 || endX >= N || endY >= N) continue;
+                    for (uint8_t i = 0; i < K; i++) {
+                        uint8_t cell = (y + dirs[d][1] * i) * N + (x + dirs[d][0] * i);
+                        lines.cells[line][i] = cell;
+                        lines.cellLines[cell][lines.cellLineCount[cell]++] = line;
+                    }
+                    line++;
+                }
+            }
+        }
+        return lines;
+    }
+};
+
+// Motor N x N com K em linha. Mantém, por janela, quantas peças cada jogador
+// tem nela; a avaliação e a detecção de vitória são atualizadas a cada
+// jogada em O(janelas da célula). A busca é negamax alfa-beta com
+// aprofundamento iterativo sob um orçamento de tempo por jogada.
+template <uint8_t N, uint8_t K>
+class GridEngine {
+    static_assert(N * N <= 32, "o tabuleiro deve caber em uma máscara de 32 bits");
+    static_assert(K >= 2 && K <= N, "comprimento de vitória inválido");
+
+public:
+    typedef GridLines<N, K> Lines;
+
+    static constexpr uint8_t SIZE = N;
+    static constexpr uint8_t WIN_LENGTH = K;
+    static constexpr uint8_t CELL_COUNT = Lines::CELL_COUNT;
+    static constexpr uint16_t LINE_COUNT = Lines::LINE_COUNT;
+    static constexpr int32_t WIN_SCORE = 1000000;
+
+    GridEngine() {
+        clear();
+    }
+
+    static uint8_t cellIndex(uint8_t x, uint8_t y) {
+        return y * N + x;
+    }
+
+    void clear() {
+        masks[0] = 0;
+        masks[1] = 0;
+        score = 0;
+        completeLines[0] = 0;
+        completeLines[1] = 0;
+        for (uint16_t i = 0; i < LINE_COUNT; i++) {
+            counts[i][0] = 0;
+            counts[i][1] = 0;
+        }
+    }
+
+    // Retorna 0 = vazio, 1 = IA, 2 = Humano
+    uint8_t get(uint8_t cell) const {
+        uint32_t bit = 1u << cell;
+        if (masks[0] & bit) return 1;
+        if (masks[1] & bit) return 2;
+        return 0;
+    }
+
+    uint8_t get(uint8_t x, uint8_t y) const {
+        return get(cellIndex(x, y));
+    }
+
+    uint32_t emptyMask() const {
+        uint32_t full = (CELL_COUNT == 32) ? 0xFFFFFFFFu : ((1u << CELL_COUNT) - 1);
+        return ~(masks[0] | masks[1]) & full;
+    }
+
+    uint8_t moveCount() const {
+        return __builtin_popcount(masks[0] | masks[1]);
+    }
+
+    uint8_t winner() const {
+        if (completeLines[0]) return 1;
+        if (completeLines[1]) return 2;
+        return 0;
+    }
+
+    bool isFull() const {
+        return moveCount() == CELL_COUNT;
+    }
+
+    void makeMove(uint8_t cell, uint8_t player) {
+        uint8_t p = player - 1;
+        masks[p] |= 1u << cell;
+        for (uint8_t i = 0; i < LINES.cellLineCount[cell]; i++) {
+            uint16_t line = LINES.cellLines[cell][i];
+            score -= lineValue(line);
+            if (++counts[line][p] == K) completeLines[p]++;
+            score += lineValue(line);
+        }
+    }
+
+    void unmakeMove(uint8_t cell, uint8_t player) {
+        uint8_t p = player - 1;
+        masks[p] &= ~(1u << cell);
+        for (uint8_t i = 0; i < LINES.cellLineCount[cell]; i++) {
+            uint16_t line = LINES.cellLines[cell][i];
+            score -= lineValue(line);
+            if (counts[line][p]-- == K) completeLines[p]--;
+            score += lineValue(line);
+        }
+    }
+
+    // Avaliação heurística do ponto de vista de 'player'
+    int32_t evaluate(uint8_t player) const {
+        return (player == 1) ? score : -score;
+    }
+
+    // Aprofunda até esgotar a árvore ou estourar 'budgetUs'. A jogada
+    // devolvida é sempre a da última profundidade concluída.
+    bool search(uint8_t player, uint32_t budgetUs, GridSearchResult& result) {
+        uint64_t start = halTimeUs();
+        deadline = start + budgetUs;
+        nodes = 0;
+        aborted = false;
+
+        result.move = -1;
+        result.score = 0;
+        result.depth = 0;
+        result.exact = false;
+
+        uint32_t empty = emptyMask();
+        if (empty == 0 || winner() != 0) {
+            result.nodes = 0;
+            result.timeUs = 0;
+            return false;
+        }
+
+        // Sem tempo nenhum ainda devolve a jogada mais promissora
+        uint8_t order[CELL_COUNT];
+        orderMoves(player, CELL_COUNT, order);
+        result.move = order[0];
+
+        uint8_t remaining = __builtin_popcount(empty);
+        for (uint8_t depth = 1; depth <= remaining; depth++) {
+            horizonReached = false;
+            int32_t best = -WIN_SCORE - 1;
+            int8_t bestMove = -1;
+            int32_t alpha = -WIN_SCORE - 1;
+            uint8_t opponent = (player == 1) ? 2 : 1;
+
+            orderMoves(player, result.move, order);
+            uint8_t count = __builtin_popcount(empty);
+            for (uint8_t i = 0; i < count; i++) {
+                makeMove(order[i], player);
+                int32_t value = -negamax(opponent, depth - 1, 1, -WIN_SCORE - 1, -alpha);
+                unmakeMove(order[i], player);
+                if (aborted) break;
+                if (value > best) {
+                    best = value;
+                    bestMove = order[i];
+                }
+                if (best > alpha) alpha = best;
+            }
+            if (aborted) break;
+
+            result.move = bestMove;
+            result.score = best;
+            result.depth = depth;
+            // Sem folhas no horizonte, ou vitória/derrota forçada: valor exato
+            if (!horizonReached || best >= WIN_SCORE - CELL_COUNT || best <= -WIN_SCORE + CELL_COUNT) {
+                result.exact = true;
+                break;
+            }
+        }
+
+        result.nodes = nodes;
+        result.timeUs = (uint32_t)(halTimeUs() - start);
+        return true;
+    }
+
+private:
+    static constexpr Lines LINES = Lines::build();
+
+    uint32_t masks[2];
+    uint8_t counts[LINE_COUNT][2];
+    uint8_t completeLines[2];
+    int32_t score;           // avaliação incremental do ponto de vista da IA
+
+    uint64_t deadline;
+    uint32_t nodes;
+    bool aborted;
+    bool horizonReached;
+
+    // Peso de uma janela com 'count' peças de um só jogador
+    static int32_t lineWeight(uint8_t count) {
+        return count == 0 ? 0 : (int32_t)1 << (3 * (count - 1));
+    }
+
+    int32_t lineValue(uint16_t line) const {
+        uint8_t mine = counts[line][0];
+        uint8_t theirs = counts[line][1];
+        if (mine && theirs) return 0;
+        return lineWeight(mine) - lineWeight(theirs);
+    }
+
+    // Ordena as casas vazias pelo potencial das janelas que passam por elas;
+    // 'first' (jogada da iteração anterior) vai na frente
+    void orderMoves(uint8_t player, uint8_t first, uint8_t* order) const {
+        int32_t keys[CELL_COUNT];
+        uint8_t count = 0;
+        uint32_t empty = emptyMask();
+        uint8_t p = player - 1;
+
+        for (uint8_t cell = 0; cell < CELL_COUNT; cell++) {
+            if (!(empty & (1u << cell))) continue;
+            int32_t key = 0;
+            if (cell == first) {
+                key = WIN_SCORE;
+            } else {
+                for (uint8_t i = 0; i < LINES.cellLineCount[cell]; i++) {
+                    uint16_t line = LINES.cellLines[cell][i];
+                    uint8_t mine = counts[line][p];
+                    uint8_t theirs = counts[line][1 - p];
+                    // Completar a própria linha vale mais do que bloquear
+                    if (!theirs) key += 2 * lineWeight(mine + 1);
+                    if (!mine) key += lineWeight(theirs + 1);
+                }
+            }
+            // Inserção ordenada decrescente
+            uint8_t j = count++;
+            while (j > 0 && keys[j - 1] < key) {
+                keys[j] = keys[j - 1];
+                order[j] = order[j - 1];
+                j--;
+            }
+            keys[j] = key;
+            order[j] = cell;
+        }
+    }
+
+    int32_t negamax(uint8_t player, uint8_t depth, uint8_t ply, int32_t alpha, int32_t beta) {
+        nodes++;
+        if ((nodes & 255) == 0 && halTimeUs() >= deadline) aborted = true;
+        if (aborted) return 0;
+
+        if (winner() != 0) return -(WIN_SCORE - ply);
+        uint32_t empty = emptyMask();
+        if (empty == 0) return 0;
+        if (depth == 0) {
+            horizonReached = true;
+            return evaluate(player);
+        }
+
+        uint8_t order[CELL_COUNT];
+        orderMoves(player, CELL_COUNT, order);
+        uint8_t count = __builtin_popcount(empty);
+        uint8_t opponent = (player == 1) ? 2 : 1;
+        int32_t best = -WIN_SCORE - 1;
+
+        for (uint8_t i = 0; i < count; i++) {
+            makeMove(order[i], player);
+            int32_t value = -negamax(opponent, depth - 1, ply + 1, -beta, -alpha);
+            unmakeMove(order[i], player);
+            if (aborted) return 0;
+            if (value > best) best = value;
+            if (best > alpha) alpha = best;
+            if (alpha >= beta) break;
+        }
+        return best;
+    }
+};
+
+// Configurações usadas pelo jogo na matriz de LEDs
+typedef GridEngine<4, 3> Grid4x4Engine;
+typedef GridEngine<5, 4> Grid5x5Engine;
+
+#endif // GRID_ENGINE_HPP
@@ -0,0 +1,74 @@
+#ifndef HAL_HPP
+#define HAL_HPP
+
+#include <stdint.h>
+
+// Camada fina de hardware usada pelo jogo: tempo, GPIO e ADC.
+// No Pico as funções chamam o SDK (HalPico.cpp). No host (TICTACTOE_HOST)
+// são um simulador dirigido por roteiro (host/HalHost.cpp).
+// A saída de LEDs é a própria classe WS2812: PIO/DMA em WS2812Pio.cpp no
+// Pico, halLedShow() do simulador em host/WS2812Host.cpp.
+
+void halInit();
+// Sempre true no Pico; no host fica false quando o roteiro de entrada termina
+bool halRunning();
+
+uint64_t halTimeUs();
+uint32_t halTimeMs();
+void halSleepMs(uint32_t ms);
+void halSleepUs(uint32_t us);
+
+void halGpioInitInput(uint32_t pin, bool pullUp);
+bool halGpioGet(uint32_t pin);
+
+void halAdcInit();
+void halAdcGpioInit(uint32_t pin);
+void halAdcSelect(uint32_t input);
+uint16_t halAdcRead();
+
+// Caractere recebido pelo stdio, sem bloquear; -1 se não há
+int halConsoleRead();
+
+// Fontes da fila de eventos (EventQueue.hpp). No Pico postam em contexto
+// de interrupção; no host o simulador posta ao aplicar o roteiro.
+// Bordas de descida e subida do pino viram EVENT_GPIO_FALL/RISE
+void halGpioEnableEvents(uint32_t pin);
+// Alarme 'id' (< EVENT_TIMER_SLOTS) que posta 'type' a cada 'periodUs',
+// ou uma vez só; reiniciar um alarme ativo recomeça a contagem
+void halTimerStart(uint32_t id, uint8_t type, uint32_t periodUs, bool repeat);
+void halTimerStop(uint32_t id);
+bool halTimerActive(uint32_t id);
+// Dorme (WFI) até a próxima interrupção, se a fila estiver vazia
+void halWaitForEvent();
+// Tempo total dormindo em halWaitForEvent
+uint64_t halIdleUs();
+
+// Flash de programa, com 'offset' a partir do início da flash. Como numa
+// NOR, apagar leva um setor inteiro a 0xFF e gravar uma página só leva
+// bits de 1 para 0, então a mesma página pode ser gravada de novo nos bytes
+// ainda em 0xFF. No Pico as duas operações param o XIP com as interrupções
+// mascaradas: ~1 ms por página, dezenas de ms por setor.
+#define HAL_FLASH_SECTOR_SIZE 4096
+#define HAL_FLASH_PAGE_SIZE 256
+uint32_t halFlashSize();
+const uint8_t *halFlashRead(uint32_t offset);
+void halFlashErase(uint32_t sectorOffset);
+void halFlashProgram(uint32_t pageOffset, const uint8_t *page);
+
+#ifdef TICTACTOE_HOST
+// Quadro de LEDs em RGB (mesmo formato de WS2812::RGB) para o terminal
+void halLedShow(uint32_t pin, const uint32_t *rgb, uint32_t length);
+// Valor que o roteiro dava à entrada do ADC no instante 'timeUs' (já passado);
+// usado pela amostragem contínua do ADC (AdcSampler)
+uint16_t halAdcSampleAt(uint32_t input, uint64_t timeUs);
+// Flash simulada em memória, espelhada no arquivo 'path' (criado apagado se
+// não existir); halInit usa TICTACTOE_FLASH. nullptr volta à flash só em
+// memória, apagada
+bool halFlashAttach(const char *path);
+// Queda de energia: só mais 'bytes' bytes são gravados (a página em curso
+// fica pela metade) e nada mais muda até halFlashPowerCut(-1)
+void halFlashPowerCut(int32_t bytes);
+uint32_t halFlashEraseCount(uint32_t sectorOffset);
+#endif
+
+#endif // HAL_HPP
@@ -0,0 +1,147 @@
+#include "Hal.hpp"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/flash.h"
+#include "EventQueue.hpp"
+
+typedef struct {
+    repeating_timer_t timer;
+    uint8_t type;
+    bool repeat;
+    volatile bool active;
+} HalTimer;
+
+static HalTimer timers[EVENT_TIMER_SLOTS];
+static uint64_t idleUs = 0;
+
+void halInit() {
+    stdio_init_all();
+}
+
+bool halRunning() {
+    return true;
+}
+
+uint64_t halTimeUs() {
+    return time_us_64();
+}
+
+uint32_t halTimeMs() {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+void halSleepMs(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void halSleepUs(uint32_t us) {
+    sleep_us(us);
+}
+
+int halConsoleRead() {
+    int c = getchar_timeout_us(0);
+    return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+void halGpioInitInput(uint32_t pin, bool pullUp) {
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    if (pullUp) gpio_pull_up(pin);
+}
+
+bool halGpioGet(uint32_t pin) {
+    return gpio_get(pin);
+}
+
+void halAdcInit() {
+    adc_init();
+}
+
+void halAdcGpioInit(uint32_t pin) {
+    adc_gpio_init(pin);
+}
+
+void halAdcSelect(uint32_t input) {
+    adc_select_input(input);
+}
+
+uint16_t halAdcRead() {
+    return adc_read();
+}
+
+static void gpioCallback(uint gpio, uint32_t events) {
+    uint32_t now = (uint32_t)time_us_64();
+    if (events & GPIO_IRQ_EDGE_FALL) eventPost(EVENT_GPIO_FALL, gpio, now);
+    if (events & GPIO_IRQ_EDGE_RISE) eventPost(EVENT_GPIO_RISE, gpio, now);
+}
+
+void halGpioEnableEvents(uint32_t pin) {
+    gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, gpioCallback);
+}
+
+static bool timerCallback(repeating_timer_t *rt) {
+    uint32_t id = (uint32_t)(uintptr_t)rt->user_data;
+    eventPost((EventType)timers[id].type, id, (uint32_t)time_us_64());
+    if (!timers[id].repeat) timers[id].active = false;
+    return timers[id].repeat;
+}
+
+void halTimerStart(uint32_t id, uint8_t type, uint32_t periodUs, bool repeat) {
+    if (id >= EVENT_TIMER_SLOTS) return;
+    halTimerStop(id);
+    timers[id].type = type;
+    timers[id].repeat = repeat;
+    timers[id].active = true;
+    // Atraso negativo: período medido entre inícios, sem acumular atraso do callback
+    add_repeating_timer_us(-(int64_t)periodUs, timerCallback, (void *)(uintptr_t)id, &timers[id].timer);
+}
+
+void halTimerStop(uint32_t id) {
+    if (id >= EVENT_TIMER_SLOTS || !timers[id].active) return;
+    cancel_repeating_timer(&timers[id].timer);
+    timers[id].active = false;
+}
+
+bool halTimerActive(uint32_t id) {
+    return id < EVENT_TIMER_SLOTS && timers[id].active;
+}
+
+// Com as interrupções mascaradas o WFI ainda acorda com uma pendente, então
+// um evento postado entre a verificação e o WFI não se perde
+void halWaitForEvent() {
+    uint32_t status = save_and_disable_interrupts();
+    if (!eventPending()) {
+        uint64_t start = time_us_64();
+        __wfi();
+        idleUs += time_us_64() - start;
+    }
+    restore_interrupts(status);
+}
+
+uint64_t halIdleUs() {
+    return idleUs;
+}
+
+uint32_t halFlashSize() {
+    return PICO_FLASH_SIZE_BYTES;
+}
+
+const uint8_t *halFlashRead(uint32_t offset) {
+    return (const uint8_t *)(uintptr_t)(XIP_BASE + offset);
+}
+
+// O SDK roda as rotinas da flash a partir da RAM; as interrupções ficam
+// mascaradas porque os handlers estão na flash, inacessível durante a operação
+void halFlashErase(uint32_t sectorOffset) {
+    uint32_t status = save_and_disable_interrupts();
+    flash_range_erase(sectorOffset, FLASH_SECTOR_SIZE);
+    restore_interrupts(status);
+}
+
+void halFlashProgram(uint32_t pageOffset, const uint8_t *page) {
+    uint32_t status = save_and_disable_interrupts();
+    flash_range_program(pageOffset, page, FLASH_PAGE_SIZE);
+    restore_interrupts(status);
+}
@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include "Hal.hpp"
+#include "Input.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+
+#define JOYSTICK_X_PIN 26          // ADC0
+#define JOYSTICK_Y_PIN 27          // ADC1
+#define MIC_PIN 28                 // ADC2
+#define JOYSTICK_BUTTON_PIN 22
+#define BOTTON_RESET_PIN 5
+#define JOYSTICK_X_INPUT 0
+#define JOYSTICK_Y_INPUT 1
+#define MIC_ADC_INPUT 2
+#define MIC_BLOCK_SAMPLES 128
+#define DEBOUNCE_DELAY_MS 200      // intervalo mínimo entre movimentos do cursor
+#define BUTTON_DEBOUNCE_US 20000   // bordas de um mesmo botão mais próximas são repique
+#define INPUT_PERIOD_US 10000      // varredura dos eixos do joystick
+#define MODE_HOLD_US 1000000       // B segurado por esse tempo troca o modo
+
+static const char *const MODE_NAMES[2] = {"JOYSTICK", "MICROFONE"};
+
+InputLayer::InputLayer(InputMode mode)
+    : adc(INPUT_ADC_INPUTS, CLAP_SAMPLE_RATE_HZ), clapDetector(clapDefaultConfig()),
+      currentMode(mode), listening(false), holdPending(false), lastEdgeUs{0, 0},
+      lastMoveMs(0), micBaseSample(0), head(0), tail(0)
+{
+}
+
+void InputLayer::start() {
+    halAdcInit();
+    halAdcGpioInit(JOYSTICK_X_PIN);
+    halAdcGpioInit(JOYSTICK_Y_PIN);
+    halAdcGpioInit(MIC_PIN);
+    halGpioInitInput(JOYSTICK_BUTTON_PIN, true);
+    halGpioInitInput(BOTTON_RESET_PIN, true);
+
+    adc.start();
+    halGpioEnableEvents(JOYSTICK_BUTTON_PIN);
+    halGpioEnableEvents(BOTTON_RESET_PIN);
+    updateTimers();
+}
+
+void InputLayer::setMode(InputMode mode) {
+    if (mode == currentMode) return;
+    currentMode = mode;
+    // O microfone recomeça do presente, sem o que foi gravado no outro modo
+    if (mode == INPUT_MIC) {
+        adc.skip(MIC_ADC_INPUT);
+        clapDetector.reset();
+        micBaseSample = adc.samplesRead(MIC_ADC_INPUT);
+    }
+    printf(">> Entrada: modo %s\n", MODE_NAMES[mode]);
+    updateTimers();
+}
+
+void InputLayer::setListening(bool value) {
+    if (value == listening) return;
+    listening = value;
+    updateTimers();
+}
+
+// Eixos varridos só na vez do jogador no modo joystick; o microfone roda
+// sempre no modo microfone para manter a linha de base do detector
+void InputLayer::updateTimers() {
+    bool scan = listening && currentMode == INPUT_JOYSTICK;
+    if (scan != halTimerActive(TIMER_INPUT)) {
+        if (scan) halTimerStart(TIMER_INPUT, EVENT_TIMER, INPUT_PERIOD_US, true);
+        else halTimerStop(TIMER_INPUT);
+    }
+    bool mic = currentMode == INPUT_MIC;
+    if (mic != halTimerActive(TIMER_MIC)) {
+        if (mic) adc.enableBlockEvents(TIMER_MIC, MIC_BLOCK_SAMPLES);
+        else halTimerStop(TIMER_MIC);
+    }
+}
+
+void InputLayer::push(uint8_t type, uint32_t timeUs, int8_t dx, int8_t dy) {
+    uint8_t next = (head + 1) & (INPUT_ACTION_QUEUE - 1);
+    if (next == tail) return; // cheia: o laço está atrasado, descarta
+    actions[head] = {timeUs, type, dx, dy};
+    head = next;
+}
+
+bool InputLayer::poll(InputAction &action) {
+    if (tail == head) return false;
+    action = actions[tail];
+    tail = (tail + 1) & (INPUT_ACTION_QUEUE - 1);
+    return true;
+}
+
+bool InputLayer::handle(const Event &event) {
+    if (event.type == EVENT_GPIO_FALL || event.type == EVENT_GPIO_RISE) {
+        if (event.source != JOYSTICK_BUTTON_PIN && event.source != BOTTON_RESET_PIN) return false;
+        PROBE_SCOPE(PROBE_INPUT);
+        handleButton(event);
+        return true;
+    }
+    if (event.type == EVENT_ADC_READY && event.source == TIMER_MIC) {
+        processClaps(event.timeUs);
+        return true;
+    }
+    if (event.type != EVENT_TIMER) return false;
+    if (event.source == TIMER_INPUT) {
+        PROBE_SCOPE(PROBE_INPUT);
+        scanAxes(event.timeUs);
+        return true;
+    }
+    if (event.source == TIMER_HOLD) {
+        // B ainda pressionado depois de MODE_HOLD_US: troca o modo e o
+        // soltar não reinicia a partida
+        if (holdPending) {
+            holdPending = false;
+            setMode(currentMode == INPUT_MIC ? INPUT_JOYSTICK : INPUT_MIC);
+            push(ACTION_MODE, event.timeUs);
+        }
+        return true;
+    }
+    return false;
+}
+
+void InputLayer::handleButton(const Event &event) {
+    uint8_t button = (event.source == BOTTON_RESET_PIN) ? 1 : 0;
+    if (event.timeUs - lastEdgeUs[button] < BUTTON_DEBOUNCE_US) return;
+    lastEdgeUs[button] = event.timeUs;
+
+    if (button == 0) {
+        if (event.type == EVENT_GPIO_FALL && currentMode == INPUT_JOYSTICK)
+            push(ACTION_PLACE, event.timeUs);
+        return;
+    }
+
+    // Botão B: toque curto reinicia, segurado troca o modo. Soltar sem ter
+    // visto o aperto (B segurado no boot) não faz nada
+    if (event.type == EVENT_GPIO_FALL) {
+        holdPending = true;
+        halTimerStart(TIMER_HOLD, EVENT_TIMER, MODE_HOLD_US, false);
+    } else if (holdPending) {
+        holdPending = false;
+        halTimerStop(TIMER_HOLD);
+        push(ACTION_RESET, event.timeUs);
+    }
+}
+
+// Eixos do joystick a partir das últimas amostras do round-robin
+void InputLayer::scanAxes(uint32_t timeUs) {
+    int xValue = adc.latest(JOYSTICK_X_INPUT);
+    int yValue = adc.latest(JOYSTICK_Y_INPUT);
+
+    int8_t dx = (yValue < 1000) ? 1 : (yValue > 3000) ? -1 : 0;
+    int8_t dy = (xValue < 1000) ? -1 : (xValue > 3000) ? 1 : 0;
+    if (dx == 0 && dy == 0) return;
+
+    uint32_t currentTime = halTimeMs();
+    if (currentTime - lastMoveMs <= DEBOUNCE_DELAY_MS) return;
+    lastMoveMs = currentTime;
+    push(ACTION_MOVE, timeUs, dx, dy);
+}
+
+void InputLayer::processClaps(uint32_t timeUs) {
+    PROBE_SCOPE(PROBE_CLAPS);
+    // O DMA amostrou tudo desde a passada anterior; aqui só processa os blocos
+    uint16_t block[MIC_BLOCK_SAMPLES];
+    uint32_t count;
+    while ((count = adc.read(MIC_ADC_INPUT, block, MIC_BLOCK_SAMPLES)) > 0) {
+        if (clapDetector.process(block, count) > 0) {
+            uint64_t t = adc.sampleTimeUs(micBaseSample + clapDetector.lastOnsetSample());
+            logEvent(LOG_CLAP_ONSET, (int32_t)(t / 1000));
+            push(ACTION_WAKE, timeUs);
+        }
+    }
+
+    ClapEvent event;
+    if (clapDetector.poll(event)) {
+        logEvent(LOG_CLAP_GESTURE, event.claps, (int32_t)(adc.sampleTimeUs(micBaseSample + event.firstSample) / 1000));
+        push(event.gesture == CLAP_SINGLE ? ACTION_NEXT : ACTION_PLACE, timeUs);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <stdint.h>
+#include "AdcSampler.hpp"
+#include "ClapDetector.hpp"
+#include "EventQueue.hpp"
+
+// Entradas do BitDogLab: joystick nas entradas 0 e 1 do ADC, microfone na 2
+#define INPUT_ADC_INPUTS 3
+#define INPUT_ACTION_QUEUE 8    // potência de 2
+
+typedef enum : uint8_t {
+    INPUT_JOYSTICK = 0,         // eixos movem o cursor, botão do joystick joga
+    INPUT_MIC                   // uma palma avança o cursor, duas jogam
+} InputMode;
+
+// Ações abstratas do jogador, iguais para qualquer modo de entrada
+typedef enum : uint8_t {
+    ACTION_NONE = 0,
+    ACTION_MOVE,                // move o cursor em (dx, dy), y para baixo
+    ACTION_NEXT,                // cursor para a próxima casa livre
+    ACTION_PLACE,               // joga na casa do cursor
+    ACTION_RESET,               // toque curto no botão B
+    ACTION_MODE,                // B segurado: o modo já foi trocado
+    ACTION_WAKE                 // início de uma palma: só interrompe animações
+} InputActionType;
+
+typedef struct {
+    uint32_t timeUs;            // instante do evento que gerou a ação
+    uint8_t type;
+    int8_t dx;
+    int8_t dy;
+} InputAction;
+
+// Camada única de entrada: o ADC amostra joystick e microfone juntos em
+// round-robin, e os eventos da fila (bordas dos botões, alarmes, blocos do
+// ADC) viram ações do jogo. O modo pode ser trocado a qualquer momento
+// segurando o botão B; um toque curto no B reinicia a partida.
+class InputLayer {
+public:
+    InputLayer(InputMode mode);
+
+    // GPIO, ADC e fontes de eventos
+    void start();
+    InputMode mode() const { return currentMode; }
+    void setMode(InputMode mode);
+    // Eixos só são varridos na vez do jogador. As palmas geram ações
+    // sempre no modo microfone (duas palmas recomeçam a partida encerrada,
+    // como o botão); o jogo ignora as que não valem na hora
+    void setListening(bool listening);
+
+    // Trata o evento se ele for de entrada; as ações saem em poll()
+    bool handle(const Event &event);
+    bool poll(InputAction &action);
+
+    // Leitura mais recente de uma entrada do ADC (escolha da variante no boot)
+    uint16_t adcLatest(uint32_t input) { return adc.latest(input); }
+
+private:
+    AdcSampler adc;
+    ClapDetector clapDetector;
+    InputMode currentMode;
+    bool listening;
+    bool holdPending;           // B pressionado e ainda não solto nem trocou o modo
+    uint32_t lastEdgeUs[2];     // joystick, B
+    uint32_t lastMoveMs;
+    uint64_t micBaseSample;     // amostra do ADC que é a amostra 0 do detector
+
+    InputAction actions[INPUT_ACTION_QUEUE];
+    uint8_t head;
+    uint8_t tail;
+
+    void push(uint8_t type, uint32_t timeUs, int8_t dx = 0, int8_t dy = 0);
+    void handleButton(const Event &event);
+    void scanAxes(uint32_t timeUs);
+    void processClaps(uint32_t timeUs);
+    void updateTimers();
+};
+
+#endif // INPUT_HPP
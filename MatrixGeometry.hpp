@@ -0,0 +1,91 @@
+#ifndef MATRIX_GEOMETRY_HPP
+#define MATRIX_GEOMETRY_HPP
+
+#include <stdint.h>
+
+// Ordem dos LEDs no fio, a partir do canto de cima à esquerda do painel
+typedef enum : uint8_t {
+    WIRING_ROW_MAJOR = 0,       // toda linha da esquerda para a direita
+    WIRING_SERPENTINE           // linhas ímpares da direita para a esquerda
+} MatrixWiring;
+
+// Giro do painel montado em relação ao desenho, no sentido horário
+typedef enum : uint8_t {
+    ROTATE_0 = 0,
+    ROTATE_90,
+    ROTATE_180,
+    ROTATE_270
+} MatrixRotation;
+
+// Painel visto pelo desenho: tamanho lógico e o índice no fio de cada
+// (x, y), linha a linha (indices[y * width + x])
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint16_t *indices;
+} MatrixGeometry;
+
+// Painel de PanelWidth x PanelHeight LEDs. A tabela de índices é gerada na
+// compilação e fica na flash; com giro de 90 ou 270 graus largura e altura
+// do desenho trocam.
+template <uint8_t PanelWidth, uint8_t PanelHeight, MatrixWiring Wiring = WIRING_ROW_MAJOR,
+          MatrixRotation Rotation = ROTATE_0>
+struct MatrixLayout {
+    static constexpr bool SWAPPED = Rotation == ROTATE_90 || Rotation == ROTATE_270;
+    static constexpr uint8_t WIDTH = SWAPPED ? PanelHeight : PanelWidth;
+    static constexpr uint8_t HEIGHT = SWAPPED ? PanelWidth : PanelHeight;
+    static constexpr uint16_t LED_COUNT = PanelWidth * PanelHeight;
+
+    // Índice no fio calculado: o desenho vai para a posição no painel, e a
+    // linha do painel decide o sentido
+    static constexpr uint16_t index(uint8_t x, uint8_t y) {
+        uint8_t px = x, py = y;
+        switch (Rotation) {
+            case ROTATE_90:  px = y; py = PanelHeight - 1 - x; break;
+            case ROTATE_180: px = PanelWidth - 1 - x; py = PanelHeight - 1 - y; break;
+            case ROTATE_270: px = PanelWidth - 1 - y; py = x; break;
+            default: break;
+        }
+        uint8_t column = (Wiring == WIRING_SERPENTINE && (py & 1)) ? PanelWidth - 1 - px : px;
+        return py * PanelWidth + column;
+    }
+
+    typedef struct {
+        uint16_t indices[LED_COUNT];
+    } Table;
+
+    static constexpr Table build() {
+        Table table = {};
+        for (uint8_t y = 0; y < HEIGHT; y++)
+            for (uint8_t x = 0; x < WIDTH; x++)
+                table.indices[y * WIDTH + x] = index(x, y);
+        return table;
+    }
+
+    static constexpr Table TABLE = build();
+
+    static constexpr MatrixGeometry geometry() {
+        return {WIDTH, HEIGHT, TABLE.indices};
+    }
+};
+
+// Painel do projeto. O BitDogLab tem a matriz 5x5 em ordem de linhas; para
+// outros painéis, ex.: -DTICTACTOE_PANEL_WIDTH=16 -DTICTACTOE_PANEL_HEIGHT=16
+// -DTICTACTOE_PANEL_WIRING=WIRING_SERPENTINE -DTICTACTOE_PANEL_ROTATION=ROTATE_90
+#ifndef TICTACTOE_PANEL_WIDTH
+#define TICTACTOE_PANEL_WIDTH 5
+#endif
+#ifndef TICTACTOE_PANEL_HEIGHT
+#define TICTACTOE_PANEL_HEIGHT 5
+#endif
+#ifndef TICTACTOE_PANEL_WIRING
+#define TICTACTOE_PANEL_WIRING WIRING_ROW_MAJOR
+#endif
+#ifndef TICTACTOE_PANEL_ROTATION
+#define TICTACTOE_PANEL_ROTATION ROTATE_0
+#endif
+
+typedef MatrixLayout<TICTACTOE_PANEL_WIDTH, TICTACTOE_PANEL_HEIGHT, TICTACTOE_PANEL_WIRING,
+                     TICTACTOE_PANEL_ROTATION> PanelLayout;
+
+#endif // MATRIX_GEOMETRY_HPP
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include "Probe.hpp"
+#include "EventQueue.hpp"
+
+static const char *const PROBE_NAMES[PROBE_COUNT] = {
+    "laço", "entrada", "palmas", "IA", "desenho", "show", "flash", "botão->LED"
+};
+
+static ProbeStats stats[PROBE_COUNT];
+static uint64_t resetUs = 0;
+static uint64_t resetIdleUs = 0;
+
+static uint32_t bucketOf(uint32_t us) {
+    if (us < 2 * PROBE_SUB_BUCKETS) return us;
+    uint32_t msb = 31 - __builtin_clz(us);
+    uint32_t bucket = (msb - 1) * PROBE_SUB_BUCKETS + ((us >> (msb - 2)) & (PROBE_SUB_BUCKETS - 1));
+    return bucket < PROBE_BUCKETS ? bucket : PROBE_BUCKETS - 1;
+}
+
+static uint32_t bucketLowerBound(uint32_t bucket) {
+    if (bucket < 2 * PROBE_SUB_BUCKETS) return bucket;
+    uint32_t msb = bucket / PROBE_SUB_BUCKETS + 1;
+    return (PROBE_SUB_BUCKETS + bucket % PROBE_SUB_BUCKETS) << (msb - 2);
+}
+
+void probeRecord(ProbeId id, uint32_t us) {
+    ProbeStats &s = stats[id];
+    if (s.count == 0 || us < s.minUs) s.minUs = us;
+    if (us > s.maxUs) s.maxUs = us;
+    s.count++;
+    s.totalUs += us;
+    s.buckets[bucketOf(us)]++;
+}
+
+const ProbeStats &probeStats(ProbeId id) {
+    return stats[id];
+}
+
+uint32_t probePercentile(ProbeId id, uint32_t permille) {
+    const ProbeStats &s = stats[id];
+    if (s.count == 0) return 0;
+    uint32_t rank = (uint32_t)(((uint64_t)s.count * permille + 999) / 1000);
+    if (rank == 0) rank = 1;
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < PROBE_BUCKETS; b++) {
+        seen += s.buckets[b];
+        if (seen >= rank) {
+            uint32_t upper = (b + 1 < PROBE_BUCKETS) ? bucketLowerBound(b + 1) - 1 : s.maxUs;
+            return upper < s.maxUs ? upper : s.maxUs;
+        }
+    }
+    return s.maxUs;
+}
+
+void probeReset() {
+    for (uint32_t i = 0; i < PROBE_COUNT; i++) stats[i] = ProbeStats();
+    resetUs = halTimeUs();
+    resetIdleUs = halIdleUs();
+}
+
+void probeDump() {
+    uint64_t loopUs = stats[PROBE_LOOP].totalUs;
+    printf("Sondas (us)   amostras     mín     p50     p99     máx   total ms  %% do laço\n");
+    for (uint32_t i = 0; i < PROBE_COUNT; i++) {
+        const ProbeStats &s = stats[i];
+        if (s.count == 0) continue;
+        // Alinha pelo número de caracteres, não de bytes (nomes em UTF-8)
+        int width = 0;
+        for (const char *c = PROBE_NAMES[i]; *c; c++) width += (*c & 0xC0) != 0x80;
+        printf("%s%*s %10lu %7lu %7lu %7lu %7lu %10.1f %10.1f\n", PROBE_NAMES[i], 11 - width, "",
+               (unsigned long)s.count, (unsigned long)s.minUs,
+               (unsigned long)probePercentile((ProbeId)i, 500),
+               (unsigned long)probePercentile((ProbeId)i, 990),
+               (unsigned long)s.maxUs, s.totalUs / 1000.0,
+               (loopUs && i < PROBE_EVENT_LATENCY) ? 100.0 * s.totalUs / loopUs : 0.0);
+    }
+
+    // Dormindo = dentro de halWaitForEvent; os laços com sleep contam como acordados
+    uint64_t elapsed = halTimeUs() - resetUs;
+    uint64_t idle = halIdleUs() - resetIdleUs;
+    printf("Acordado %.2f%% de %.1f s (%.1f s em WFI), %lu eventos descartados\n",
+           elapsed ? 100.0 * (elapsed - idle) / elapsed : 0.0, elapsed / 1e6, idle / 1e6,
+           (unsigned long)eventDropped());
+}
+
+void probePollCommands() {
+    int c;
+    while ((c = halConsoleRead()) >= 0) {
+        if (c == 'p') probeDump();
+        else if (c == 'r') {
+            probeReset();
+            printf("Sondas zeradas\n");
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef PROBE_HPP
+#define PROBE_HPP
+
+#include <stdint.h>
+#include "Hal.hpp"
+
+// 0 remove as sondas do binário; ligadas por padrão, custam duas leituras
+// do timer e algumas somas por medida
+#ifndef TICTACTOE_PROBES
+#define TICTACTOE_PROBES 1
+#endif
+
+// Histograma log-linear: 4 faixas por potência de 2 (erro < 25%),
+// exato até 8 us, última faixa a partir de ~16 s
+#define PROBE_SUB_BUCKETS 4
+#define PROBE_BUCKETS 96
+
+// Trechos medidos. PROBE_LOOP é a passada inteira do laço, sem o sleep;
+// PROBE_SHOW também está contido em PROBE_DRAW. PROBE_EVENT_LATENCY não é
+// trecho do laço: vai da interrupção do botão ao quadro entregue ao DMA
+typedef enum {
+    PROBE_LOOP = 0,
+    PROBE_INPUT,
+    PROBE_CLAPS,
+    PROBE_AI,
+    PROBE_DRAW,
+    PROBE_SHOW,
+    PROBE_FLASH,                // um passo da gravação de partidas na flash
+    PROBE_EVENT_LATENCY,
+    PROBE_COUNT
+} ProbeId;
+
+typedef struct {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t buckets[PROBE_BUCKETS];
+} ProbeStats;
+
+void probeRecord(ProbeId id, uint32_t us);
+const ProbeStats &probeStats(ProbeId id);
+// Limite superior da faixa que contém o percentil (em milésimos), até o máximo visto
+uint32_t probePercentile(ProbeId id, uint32_t permille);
+void probeReset();
+void probeDump();
+// Comandos pelo stdio, sem afetar o jogo: 'p' imprime as sondas, 'r' as zera
+void probePollCommands();
+
+// Mede do construtor até stop() ou até sair do escopo
+class ProbeScope {
+public:
+    explicit ProbeScope(ProbeId id) : id(id), startUs(halTimeUs()), running(true) {}
+    ~ProbeScope() { stop(); }
+
+    void stop() {
+        if (!running) return;
+        running = false;
+        probeRecord(id, (uint32_t)(halTimeUs() - startUs));
+    }
+
+private:
+    ProbeId id;
+    uint64_t startUs;
+    bool running;
+};
+
+// Uma sonda por escopo; PROBE_STOP encerra antes do fim (ex.: antes do sleep)
+#if TICTACTOE_PROBES
+#define PROBE_SCOPE(id) ProbeScope probeScope(id)
+#define PROBE_STOP() probeScope.stop()
+#else
+#define PROBE_SCOPE(id) do {} while (0)
+#define PROBE_STOP() do {} while (0)
+#endif
+
+#endif // PROBE_HPP
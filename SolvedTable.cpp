@@ -0,0 +1,104 @@
+#include "SolvedTable.hpp"
+#include "TicTacToeAI.hpp"
+
+static constexpr uint16_t POW3[BitBoard::CELL_COUNT] = {1, 3, 9, 27, 81, 243, 729, 2187, 6561};
+
+static constexpr uint8_t countBits(uint16_t mask) {
+    uint8_t count = 0;
+    for (; mask; mask &= mask - 1) count++;
+    return count;
+}
+
+static constexpr bool isWinning(uint16_t mask) {
+    for (uint8_t i = 0; i < BitBoard::WIN_LINE_COUNT; i++) {
+        if ((mask & BitBoard::WIN_LINES[i]) == BitBoard::WIN_LINES[i]) return true;
+    }
+    return false;
+}
+
+static constexpr uint16_t packEntry(uint16_t bestMoves, int score) {
+    return bestMoves | (uint16_t)((score + SolvedTable::SCORE_BIAS) << 9);
+}
+
+// Análise retrógrada: colocar uma peça sempre aumenta o índice em base 3,
+// então percorrendo do maior índice para o menor os filhos já estão prontos.
+static constexpr SolvedTable buildSolvedTable() {
+    SolvedTable table = {};
+
+    for (int32_t index = SolvedTable::POSITION_COUNT - 1; index >= 0; index--) {
+        uint16_t masks[2] = {0, 0};
+        int32_t rest = index;
+        for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+            uint8_t digit = rest % 3;
+            rest /= 3;
+            if (digit != 0) masks[digit - 1] |= 1u << cell;
+        }
+
+        uint8_t aiPieces = countBits(masks[0]);
+        uint8_t humanPieces = countBits(masks[1]);
+        uint8_t pieces = aiPieces + humanPieces;
+        if (aiPieces != humanPieces && aiPieces != humanPieces + 1) continue;
+        if (isWinning(masks[0]) || isWinning(masks[1]) || pieces == BitBoard::CELL_COUNT) continue;
+
+        uint8_t player = (aiPieces == humanPieces) ? 1 : 2;
+        int best = -128;
+        uint16_t bestMoves = 0;
+
+        for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+            uint16_t bit = 1u << cell;
+            if ((masks[0] | masks[1]) & bit) continue;
+
+            int score = 0;
+            if (isWinning(masks[player - 1] | bit)) {
+                score = TicTacToeAI::WIN_SCORE + BitBoard::CELL_COUNT - (pieces + 1);
+            } else if (pieces + 1 == BitBoard::CELL_COUNT) {
+                score = 0;
+            } else {
+                uint16_t child = table.entries[index + player * POW3[cell]];
+                score = -solvedScore(child);
+            }
+
+            if (score > best) {
+                best = score;
+                bestMoves = bit;
+            } else if (score == best) {
+                bestMoves |= bit;
+            }
+        }
+
+        table.entries[index] = packEntry(bestMoves, best);
+    }
+
+    return table;
+}
+
+typedef struct {
+    uint16_t values[1 << BitBoard::CELL_COUNT];
+} Base3Table;
+
+// Soma de 3^i para cada bit i da máscara
+static constexpr Base3Table buildBase3Table() {
+    Base3Table table = {};
+    for (uint16_t mask = 0; mask <= BitBoard::FULL_MASK; mask++) {
+        for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+            if (mask & (1u << cell)) table.values[mask] += POW3[cell];
+        }
+    }
+    return table;
+}
+
+constexpr SolvedTable SOLVED_TABLE = buildSolvedTable();
+
+static constexpr Base3Table BASE3 = buildBase3Table();
+
+// Conferências feitas pelo compilador
+static_assert(sizeof(SOLVED_TABLE) == SolvedTable::POSITION_COUNT * sizeof(uint16_t),
+              "tabela resolvida deve ocupar 2 bytes por posição");
+static_assert(solvedScore(SOLVED_TABLE.entries[0]) == 0,
+              "o jogo perfeito a partir do tabuleiro vazio deve empatar");
+static_assert(solvedBestMoves(SOLVED_TABLE.entries[0]) == BitBoard::FULL_MASK,
+              "todas as aberturas empatam com jogo perfeito");
+
+uint16_t solvedTableIndex(const BitBoard& board) {
+    return BASE3.values[board.playerMask(1)] + 2 * BASE3.values[board.playerMask(2)];
+}
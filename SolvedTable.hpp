@@ -0,0 +1,38 @@
+#ifndef SOLVED_TABLE_HPP
+#define SOLVED_TABLE_HPP
+
+#include <stdint.h>
+#include "BitBoard.hpp"
+
+// Jogo resolvido em tempo de compilação: uma entrada de 16 bits para cada uma
+// das 3^9 posições (índice em base 3, dígito 0 = vazio, 1 = IA, 2 = Humano).
+// A tabela é const e fica na flash (XIP), sem custo de RAM.
+//
+// Entrada: bits 0-8 = máscara das jogadas ótimas, bits 9-14 = valor + SCORE_BIAS
+// do ponto de vista de quem joga. Posições terminais ou inválidas valem 0.
+// Quem joga é deduzido da contagem de peças, supondo que a IA começa.
+struct SolvedTable {
+    static constexpr uint16_t POSITION_COUNT = 19683;
+    static constexpr int8_t SCORE_BIAS = 32;
+
+    uint16_t entries[POSITION_COUNT];
+};
+
+extern const SolvedTable SOLVED_TABLE;
+
+// Índice em base 3 da posição, por duas tabelas de 512 entradas
+uint16_t solvedTableIndex(const BitBoard& board);
+
+static inline uint16_t solvedLookup(const BitBoard& board) {
+    return SOLVED_TABLE.entries[solvedTableIndex(board)];
+}
+
+static constexpr uint16_t solvedBestMoves(uint16_t entry) {
+    return entry & BitBoard::FULL_MASK;
+}
+
+static constexpr int8_t solvedScore(uint16_t entry) {
+    return (int8_t)(entry >> 9) - SolvedTable::SCORE_BIAS;
+}
+
+#endif // SOLVED_TABLE_HPP
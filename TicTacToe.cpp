@@ -1,308 +1,346 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
-#include "pico/stdlib.h"
-#include "hardware/adc.h"
-#include "hardware/gpio.h"
+#include "Hal.hpp"
 #include "WS2812.hpp"
-#include "pico/time.h"
 #include "TicTacToe.hpp"
+#include "BitBoard.hpp"
+#include "SolvedTable.hpp"
+#include "Animation.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+#include "EventQueue.hpp"
+#include "BoardPicture.hpp"
+#include "BoardPalette.hpp"
 
-// Configurações do hardware
-#define LED_PIN 7
-#define LED_LENGTH 25
-#define JOYSTICK_X_PIN 26  // ADC0
-#define JOYSTICK_Y_PIN 27  // ADC1
-#define JOYSTICK_BUTTON_PIN 22
-#define DEBOUNCE_DELAY_MS 200
-#define BOTTON_RESET_PIN 5
-
-// Mapeamento da matriz de LEDs
-const Position ledMap[3][3] = {
-    {{0,0}, {2,0}, {4,0}},
-    {{0,2}, {2,2}, {4,2}},
-    {{0,4}, {2,4}, {4,4}}
-};
-
-// Cores melhoradas
-const uint32_t COLOR_GRID = WS2812::RGB(2, 2, 0);
-const uint32_t COLOR_CURSOR = WS2812::RGB(0, 0, 30);
-const uint32_t COLOR_PLAYER1 = WS2812::RGB(30, 0, 0);
-const uint32_t COLOR_PLAYER2 = WS2812::RGB(0, 0, 30);
-const uint32_t COLOR_WIN = WS2812::RGB(0, 30, 0);
-const uint32_t COLOR_DRAW = WS2812::RGB(20, 20, 0);
-
-// Estado do jogo
-uint8_t board[3][3] = {0}; // 0 = vazio, 1 = IA, 2 = Humano
-uint8_t currentPlayer = 1;  // IA começa
-Position cursor = {1, 1};   // Posição do cursor
-bool gameActive = true;
-
-// Mapeamento da matriz de LEDs
-const int gridIndices[5][5] = {
-    { 0,  1,  2,  3,  4},
-    { 5,  6,  7,  8,  9},
-    {10, 11, 12, 13, 14},
-    {15, 16, 17, 18, 19},
-    {20, 21, 22, 23, 24}
-};
-
-// Inicialização do hardware
-void initHardware() {
-    stdio_init_all();
-    
-    // Inicializa ADC para o joystick
-    adc_init();
-    adc_gpio_init(JOYSTICK_X_PIN);
-    adc_gpio_init(JOYSTICK_Y_PIN);
-    
-    // Inicializa botão do joystick
-    gpio_init(JOYSTICK_BUTTON_PIN);
-    gpio_set_dir(JOYSTICK_BUTTON_PIN, GPIO_IN);
-    gpio_pull_up(JOYSTICK_BUTTON_PIN);
-
-    // Inicializa botão de reset
-    gpio_init(BOTTON_RESET_PIN);
-    gpio_set_dir(BOTTON_RESET_PIN, GPIO_IN);
-    gpio_pull_up(BOTTON_RESET_PIN);
-    
-    // Inicializa gerador de números aleatórios
-    srand(to_ms_since_boot(get_absolute_time()));
+// Espera da IA antes de jogar
+#define AI_DELAY_MS 500
+#define REPLAY_STEP_MS 700      // intervalo entre jogadas no replay
+#define STORAGE_STEP_MS 10      // intervalo entre passos da gravação na flash
+
+// Cursor na vez do humano; o resto da paleta está em BoardPalette.hpp
+static const WS2812::Color COLOR_CURSOR = WS2812::color(0, 0, 97);
+
+TicTacToe::TicTacToe(WS2812& ledStrip, InputLayer& input, GameLog& gameLog)
+    : ledStrip(ledStrip), frame(ledStrip), input(input), gameLog(gameLog), currentPlayer(1), cursor({1, 1}),
+      gameActive(true), aiTurnStart(0), replaying(false), replayIndex(0), replayStep(0)
+{
+    srand(halTimeMs());
+    record.moveCount = 0;
+    BoardPicture::attach(frame);
+}
+
+void TicTacToe::runReplay() {
+    replaying = true;
+    run();
+}
+
+void TicTacToe::run() {
+    drawBoard();
+    if (replaying) startReplay(0);
+    else startAITurn();
+    updateTimers();
+
+    while (halRunning()) {
+        // Cada passada trata o que as interrupções enfileiraram (botões,
+        // eixos, microfone, quadros de animação, vez da IA) e volta a dormir
+        PROBE_SCOPE(PROBE_LOOP);
+        Event event;
+        while (eventPop(event))
+            handleEvent(event);
+        updateAI();
+        // Um passo da gravação por passada, fora das animações: no Pico
+        // ele mascara as interrupções e atrasaria os quadros
+        if (!animator.isActive()) gameLog.service();
+        // O apagamento do setor reserva mascara as interrupções por dezenas
+        // de ms: só com a partida encerrada e a animação do fim já tocada,
+        // antes de a próxima começar
+        if (!gameActive && !replaying && !animator.isActive() && gameLog.needsErase())
+            gameLog.eraseSpare();
+        updateTimers();
+        PROBE_STOP();
+        logFlush();
+        probePollCommands();
+
+        halWaitForEvent();
+    }
 }
 
 // Desenha o tabuleiro completo
-void drawBoard(WS2812& ledStrip) {
-    ledStrip.fill(WS2812::RGB(0, 0, 0)); // Limpa tudo
+void TicTacToe::drawBoard() {
+    PROBE_SCOPE(PROBE_DRAW);
+    frame.clear(COLOR_OFF); // Limpa tudo
     
     // Desenha grade
-    for (uint8_t x = 1; x < 5; x += 2) {
-        for (uint8_t y = 0; y < 5; y++) {
-            ledStrip.setPixelColor(gridIndices[y][x], COLOR_GRID);
-        }
-    }
-    for (uint8_t y = 1; y < 5; y += 2) {
-        for (uint8_t x = 0; x < 5; x++) {
-            ledStrip.setPixelColor(gridIndices[y][x], COLOR_GRID);
-        }
-    }
+    BoardPicture::drawGrid(frame, COLOR_GRID);
     
     // Desenha jogadas
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 1) {
-                ledStrip.setPixelColor(gridIndices[ledMap[y][x].y][ledMap[y][x].x], COLOR_PLAYER1);
-            } else if (board[y][x] == 2) {
-                ledStrip.setPixelColor(gridIndices[ledMap[y][x].y][ledMap[y][x].x], COLOR_PLAYER2);
-            }
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        uint8_t player = board.get(cell);
+        if (player == 1) {
+            BoardPicture::setCell(frame, cell, COLOR_PLAYER1);
+        } else if (player == 2) {
+            BoardPicture::setCell(frame, cell, COLOR_PLAYER2);
         }
     }
     
-    // Desenha cursor (se for vez do humano e jogo ativo)
-    if (gameActive && currentPlayer == 2 && board[cursor.y][cursor.x] == 0) {
-        ledStrip.setPixelColor(gridIndices[ledMap[cursor.y][cursor.x].y][ledMap[cursor.y][cursor.x].x], COLOR_CURSOR);
+    // Desenha cursor (se for vez do humano e jogo ativo), na cor do modo de entrada
+    if (gameActive && currentPlayer == 2 && board.get(cursor.x, cursor.y) == 0) {
+        WS2812::Color color = (input.mode() == INPUT_MIC) ? COLOR_CURSOR_MIC : COLOR_CURSOR;
+        BoardPicture::setCell(frame, BitBoard::cellIndex(cursor.x, cursor.y), color);
     }
     
+    // Animações por cima do tabuleiro
+    animator.compose(ledStrip);
     ledStrip.show();
+    animator.frameShown();
 }
 
-// Processa entrada do jogador
-void processInput(WS2812& ledStrip) {
-    static uint32_t lastMoveTime = 0;
-    static bool lastButtonState = false;
-    static bool lastResetState = false;
-    
-    // Lê joystick
-    int dx = 0, dy = 0;
-    bool buttonPressed = !gpio_get(JOYSTICK_BUTTON_PIN);
+// Entrada durante uma animação: cancela e volta ao tabuleiro
+void TicTacToe::interruptAnimation(uint32_t eventUs) {
+    if (!animator.isActive()) return;
+    animator.inputReceived(eventUs);
+    animator.cancel();
+    drawBoard();
+}
 
-    // Lê botão de reset
-    bool resetPressed = !gpio_get(BOTTON_RESET_PIN);
+// Liga só os alarmes que têm trabalho: entrada na vez do humano, quadros
+// durante as animações, gravação enquanto houver partida na fila. Sem
+// nenhum, o laço dorme até um botão ou palma
+void TicTacToe::updateTimers() {
+    input.setListening(replaying || (gameActive && currentPlayer == 2));
+    animator.updateFrameTimer();
+    if (gameLog.writePending() && !halTimerActive(TIMER_STORAGE))
+        halTimerStart(TIMER_STORAGE, EVENT_TIMER, STORAGE_STEP_MS * 1000, false);
+}
 
-    // Reinicia o jogo se o botão de reset for pressionado
-    if (resetPressed && !lastResetState) {
-        resetGame(ledStrip);
-    }
-    lastResetState = resetPressed;
-    
-    // Lê eixos apenas se o jogo estiver ativo
-    if (gameActive) {
-        adc_select_input(0);
-        int xValue = adc_read();
-        adc_select_input(1);
-        int yValue = adc_read();
-        
-        dx = (yValue < 1000) ? 1 : (yValue > 3000) ? -1 : 0;
-        dy = (xValue < 1000) ? 1 : (xValue > 3000) ? -1 : 0;
+// Vez da IA: alarme único para o fim de AI_DELAY_MS
+void TicTacToe::startAITurn() {
+    aiTurnStart = halTimeMs();
+    halTimerStart(TIMER_AI, EVENT_TIMER, AI_DELAY_MS * 1000, false);
+}
+
+// Jogada da IA sem bloquear: espera AI_DELAY_MS e o fim das animações
+void TicTacToe::updateAI() {
+    if (!gameActive || currentPlayer != 1) return;
+    if (halTimeMs() - aiTurnStart < AI_DELAY_MS || animator.isActive()) return;
+
+    makeAIMove();
+    drawBoard();
+    checkGameState();
+}
+
+// Trata um evento da fila: entradas viram ações; o resto são alarmes do jogo
+void TicTacToe::handleEvent(const Event &event) {
+    if (input.handle(event)) {
+        InputAction action;
+        while (input.poll(action))
+            handleAction(action);
+    } else if (event.type == EVENT_TIMER && event.source == TIMER_FRAME) {
+        if (animator.advance()) drawBoard();
+    } else if (replaying && event.type == EVENT_TIMER && event.source == TIMER_AI) {
+        stepReplay();
     }
-    
-    // Atualiza cursor
-    uint32_t currentTime = to_ms_since_boot(get_absolute_time());
-    if (currentTime - lastMoveTime > DEBOUNCE_DELAY_MS) {
-        if (dx != 0 || dy != 0) {
-            cursor.x = (cursor.x + dx + 3) % 3;
-            cursor.y = (cursor.y - dy + 3) % 3;
-            drawBoard(ledStrip);
-            lastMoveTime = currentTime;
-        }
+    // No jogo, TIMER_AI e TIMER_STORAGE só acordam o laço; a jogada sai em
+    // updateAI e a gravação em gameLog.service()
+}
+
+void TicTacToe::handleAction(const InputAction &action) {
+    // Replay: jogar ou mover para a direita/baixo vai para a partida mais
+    // antiga, para a esquerda/cima volta; B recomeça a partida mostrada
+    if (replaying && action.type != ACTION_MODE && action.type != ACTION_WAKE) {
+        if (action.type == ACTION_RESET) startReplay(replayIndex);
+        else if (action.type == ACTION_MOVE && action.dx + action.dy < 0) startReplay(replayIndex + gameLog.count() - 1);
+        else startReplay(replayIndex + 1);
+        probeRecord(PROBE_EVENT_LATENCY, (uint32_t)halTimeUs() - action.timeUs);
+        return;
     }
-    
-    // Processa botão
-    if (buttonPressed && !lastButtonState) {
-        if (!gameActive) {
-            // Reinicia o jogo se pressionado quando inativo
-            resetGame(ledStrip);
-        } else if (currentPlayer == 2 && board[cursor.y][cursor.x] == 0) {
-            // Faz jogada humana
-            board[cursor.y][cursor.x] = 2;
-            flashPosition(ledStrip, cursor, COLOR_PLAYER2);
-            checkGameState(ledStrip);
-        }
+
+    switch (action.type) {
+    case ACTION_MOVE:
+        moveCursor(action.dx, action.dy, action.timeUs);
+        break;
+    case ACTION_NEXT:
+        nextCell();
+        break;
+    case ACTION_PLACE:
+        place(action.timeUs);
+        break;
+    case ACTION_RESET:
+        interruptAnimation(action.timeUs);
+        resetGame();
+        break;
+    case ACTION_MODE:
+        drawBoard();
+        break;
+    case ACTION_WAKE:
+        interruptAnimation(action.timeUs);
+        return;
     }
-    lastButtonState = buttonPressed;
+    // Da interrupção até o quadro entregue ao DMA
+    probeRecord(PROBE_EVENT_LATENCY, (uint32_t)halTimeUs() - action.timeUs);
 }
 
-// Implementação da IA
-void makeAIMove() {
-    // Verifica se pode ganhar na próxima jogada
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 0) {
-                board[y][x] = 1;
-                if (checkWin(1)) {
-                    return; // Jogada vencedora encontrada
-                }
-                board[y][x] = 0;
-            }
-        }
-    }
-    
-    // Verifica se precisa bloquear o jogador
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 0) {
-                board[y][x] = 2;
-                if (checkWin(2)) {
-                    board[y][x] = 1; // Bloqueia jogada vencedora
-                    return;
-                }
-                board[y][x] = 0;
-            }
-        }
+// Joystick: move o cursor com volta nas bordas
+void TicTacToe::moveCursor(int8_t dx, int8_t dy, uint32_t eventUs) {
+    if (!gameActive || currentPlayer != 2) return;
+    interruptAnimation(eventUs);
+    cursor.x = (cursor.x + dx + 3) % 3;
+    cursor.y = (cursor.y + dy + 3) % 3;
+    drawBoard();
+}
+
+// Uma palma: avança o cursor até a próxima casa vazia
+void TicTacToe::nextCell() {
+    if (!gameActive || currentPlayer != 2) return;
+    for (int i = 0; i < 9; i++) {
+        cursor.x = (cursor.x + 1) % 3;
+        if (cursor.x == 0)
+            cursor.y = (cursor.y + 1) % 3;
+        if (board.get(cursor.x, cursor.y) == 0) break;
     }
-    
-    // Escolhe um índice aleatório
-    uint8_t emptySpots = 0;
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 0) emptySpots++;
-        }
+    drawBoard();
+}
+
+// Botão do joystick ou duas palmas
+void TicTacToe::place(uint32_t eventUs) {
+    interruptAnimation(eventUs);
+    if (!gameActive) {
+        // Reinicia o jogo se jogar com a partida encerrada
+        resetGame();
+    } else if (currentPlayer == 2 && board.get(cursor.x, cursor.y) == 0) {
+        // Faz jogada humana
+        recordMove(BitBoard::cellIndex(cursor.x, cursor.y));
+        board.makeMove(BitBoard::cellIndex(cursor.x, cursor.y), 2);
+        flashPosition(cursor, 2);
+        checkGameState();
     }
+}
+
+// Implementação da IA: consulta à tabela resolvida e sorteio entre as jogadas ótimas
+void TicTacToe::makeAIMove() {
+    PROBE_SCOPE(PROBE_AI);
+    uint16_t entry = solvedLookup(board);
+    uint16_t bestMoves = solvedBestMoves(entry);
+    if (bestMoves == 0) return;
 
-    // Escolhe um índice aleatório
-    uint8_t randomChoice = rand() % emptySpots;
+    uint8_t randomChoice = rand() % __builtin_popcount(bestMoves);
     uint8_t count = 0;
 
-    // Encontra a posição correspondente ao índice escolhido
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 0) {
-                if (count == randomChoice) {
-                    board[y][x] = 1;
-                    return;
-                }
-                count++;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (bestMoves & (1u << cell)) {
+            if (count == randomChoice) {
+                recordMove(cell);
+                board.makeMove(cell, 1);
+                break;
             }
+            count++;
         }
     }
+
+    logEvent(LOG_AI_VALUE, solvedScore(entry));
 }
 
 // Verifica o estado atual do jogo
-void checkGameState(WS2812& ledStrip) {
-    if (checkWin(currentPlayer)) {
-        showWinAnimation(ledStrip, currentPlayer);
+void TicTacToe::checkGameState() {
+    if (board.checkWin(currentPlayer)) {
+        showWinAnimation(currentPlayer);
         gameActive = false;
-    } else if (isBoardFull()) {
-        showDrawAnimation(ledStrip);
+        saveGame(currentPlayer == 1 ? GAME_RESULT_AI : GAME_RESULT_HUMAN);
+    } else if (board.isFull()) {
+        showDrawAnimation();
         gameActive = false;
+        saveGame(GAME_RESULT_DRAW);
     } else {
         currentPlayer = (currentPlayer == 1) ? 2 : 1;
+        if (currentPlayer == 1) startAITurn();
     }
 }
 
 // Reinicia o jogo
-void resetGame(WS2812& ledStrip) {
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            board[y][x] = 0;
-        }
-    }
+void TicTacToe::resetGame() {
+    board.clear();
+    record.moveCount = 0;
     
     cursor = (Position){1, 1};
     currentPlayer = 1;
     gameActive = true;
-    drawBoard(ledStrip);
+    startAITurn();
+    drawBoard();
 }
 
-// Animação de vitória
-void showWinAnimation(WS2812& ledStrip, uint8_t player) {
-    uint32_t color = (player == 1) ? COLOR_PLAYER1 : COLOR_PLAYER2;
-    
-    for (uint8_t i = 0; i < 5; i++) {
-        ledStrip.fill((i % 2 == 0) ? color : WS2812::RGB(0, 0, 0));
-        ledStrip.show();
-        sleep_ms(200);
-    }
-    
-    drawBoard(ledStrip);
+void TicTacToe::recordMove(uint8_t cell) {
+    if (record.moveCount < GAME_LOG_MAX_MOVES) record.moves[record.moveCount++] = cell;
 }
 
-// Animação de empate
-void showDrawAnimation(WS2812& ledStrip) {
-    for (uint8_t i = 0; i < 3; i++) {
-        ledStrip.fill((i % 2 == 0) ? COLOR_DRAW : WS2812::RGB(0, 0, 0));
-        ledStrip.show();
-        sleep_ms(300);
+// Partida terminada: só entra na fila, a flash é gravada aos poucos no laço
+void TicTacToe::saveGame(uint8_t result) {
+    record.mode = input.mode();
+    record.result = result;
+    gameLog.append(record);
+}
+
+// Replay: tabuleiro vazio e a partida 'index' mostrada uma jogada por vez
+void TicTacToe::startReplay(uint32_t index) {
+    animator.cancel();
+    board.clear();
+    gameActive = false;
+    replayStep = 0;
+    record.moveCount = 0;
+
+    uint32_t total = gameLog.count();
+    if (total == 0) {
+        printf("Replay: nenhuma partida gravada\n");
+        drawBoard();
+        return;
     }
-    
-    drawBoard(ledStrip);
+    replayIndex = index % total;
+    gameLog.read(replayIndex, record);
+    printf("Replay: partida %lu (%lu de %lu), %u jogadas\n", (unsigned long)record.sequence,
+           (unsigned long)(replayIndex + 1), (unsigned long)total, record.moveCount);
+    drawBoard();
+    halTimerStart(TIMER_AI, EVENT_TIMER, REPLAY_STEP_MS * 1000, true);
 }
 
-// Pisca uma posição específica
-void flashPosition(WS2812& ledStrip, Position pos, uint32_t color) {
-    for (uint8_t i = 0; i < 3; i++) {
-        ledStrip.setPixelColor(gridIndices[ledMap[pos.y][pos.x].y][ledMap[pos.y][pos.x].x], 
-                              (i % 2 == 0) ? color : WS2812::RGB(0, 0, 0));
-        ledStrip.show();
-        sleep_ms(100);
+// Próxima jogada gravada; a IA sempre começa
+void TicTacToe::stepReplay() {
+    if (replayStep >= record.moveCount) return;
+    uint8_t cell = record.moves[replayStep];
+    uint8_t player = (replayStep % 2 == 0) ? 1 : 2;
+    replayStep++;
+    if (cell >= BitBoard::CELL_COUNT || !board.isEmpty(cell)) {
+        replayStep = record.moveCount;
+        halTimerStop(TIMER_AI);
+        return;
+    }
+
+    board.makeMove(cell, player);
+    flashPosition((Position){(uint8_t)(cell % 3), (uint8_t)(cell / 3)}, player);
+    if (replayStep == record.moveCount) {
+        halTimerStop(TIMER_AI);
+        showResult(record.result);
     }
 }
 
-// Funções auxiliares do jogo
-int evaluateBoard() {
-    if (checkWin(1)) return 10;
-    if (checkWin(2)) return -10;
-    return 0;
+void TicTacToe::showResult(uint8_t result) {
+    if (result == GAME_RESULT_DRAW) showDrawAnimation();
+    else showWinAnimation(result == GAME_RESULT_AI ? 1 : 2);
 }
 
-bool checkWin(uint8_t player) {
-    // Verifica linhas e colunas
-    for (uint8_t i = 0; i < 3; i++) {
-        if (board[i][0] == player && board[i][1] == player && board[i][2] == player) return true;
-        if (board[0][i] == player && board[1][i] == player && board[2][i] == player) return true;
-    }
-    
-    // Verifica diagonais
-    if (board[0][0] == player && board[1][1] == player && board[2][2] == player) return true;
-    if (board[0][2] == player && board[1][1] == player && board[2][0] == player) return true;
-    
-    return false;
+// Animação de vitória, depois das que já estão tocando
+void TicTacToe::showWinAnimation(uint8_t player) {
+    animator.play(WIN_FRAMES[player - 1], 5, Animator::WHOLE_STRIP, animator.remainingTicks());
+    drawBoard();
 }
 
-bool isBoardFull() {
-    for (uint8_t y = 0; y < 3; y++) {
-        for (uint8_t x = 0; x < 3; x++) {
-            if (board[y][x] == 0) return false;
-        }
-    }
-    return true;
+// Animação de empate
+void TicTacToe::showDrawAnimation() {
+    animator.play(DRAW_FRAMES, 3, Animator::WHOLE_STRIP, animator.remainingTicks());
+    drawBoard();
+}
+
+// Pisca a peça recém-colocada numa posição
+void TicTacToe::flashPosition(Position pos, uint8_t player) {
+    animator.play(FLASH_FRAMES[player - 1], 3, BoardPicture::cellPixel(frame, BitBoard::cellIndex(pos.x, pos.y)));
+    drawBoard();
 }
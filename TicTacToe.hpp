@@ -3,25 +3,66 @@
 
 #include <stdint.h>
 #include "WS2812.hpp"
+#include "FrameBuffer.hpp"
+#include "BitBoard.hpp"
+#include "Animation.hpp"
+#include "Input.hpp"
+#include "GameLog.hpp"
 
-// Estrutura para representar uma posição no tabuleiro
-typedef struct {
-    uint8_t x;
-    uint8_t y;
-} Position;
-
-// Funções do jogo
-void initHardware();
-void drawBoard(WS2812& ledStrip);
-void processInput(WS2812& ledStrip);
-void makeAIMove();
-void checkGameState(WS2812& ledStrip);
-void resetGame(WS2812& ledStrip);
-void showWinAnimation(WS2812& ledStrip, uint8_t player);
-void showDrawAnimation(WS2812& ledStrip);
-void flashPosition(WS2812& ledStrip, Position pos, uint32_t color);
-int evaluateBoard();
-bool checkWin(uint8_t player);
-bool isBoardFull();
+// Jogo da velha clássico 3x3 contra a tabela resolvida. As jogadas chegam
+// como ações da camada de entrada, então o mesmo jogo serve ao joystick e
+// ao microfone. Cada partida terminada vai para o log na flash, e o modo
+// replay mostra as partidas gravadas.
+class TicTacToe {
+public:
+    TicTacToe(WS2812& ledStrip, InputLayer& input, GameLog& gameLog);
+    void run();
+    // Reproduz as partidas gravadas, da mais recente para a mais antiga
+    void runReplay();
+
+private:
+    WS2812& ledStrip;
+    FrameBuffer frame;          // tabuleiro no centro do painel
+    InputLayer& input;
+    GameLog& gameLog;
+
+    // Estado do jogo
+    BitBoard board;             // 0 = vazio, 1 = IA, 2 = Humano
+    uint8_t currentPlayer;      // IA começa
+    Position cursor;
+    bool gameActive;
+    uint32_t aiTurnStart;       // início da vez da IA
+    GameRecord record;          // jogadas da partida em curso (ou reproduzida)
+
+    // Replay
+    bool replaying;
+    uint32_t replayIndex;       // 0 = partida mais recente
+    uint8_t replayStep;         // jogadas já mostradas
+
+    // Animações não bloqueantes, avançadas pelo alarme de quadros
+    Animator animator;
+
+    void drawBoard();
+    void interruptAnimation(uint32_t eventUs);
+    void handleEvent(const Event &event);
+    void handleAction(const InputAction &action);
+    void moveCursor(int8_t dx, int8_t dy, uint32_t eventUs);
+    void nextCell();
+    void place(uint32_t eventUs);
+    void updateTimers();
+    void startAITurn();
+    void updateAI();
+    void makeAIMove();
+    void checkGameState();
+    void resetGame();
+    void recordMove(uint8_t cell);
+    void saveGame(uint8_t result);
+    void startReplay(uint32_t index);
+    void stepReplay();
+    void showResult(uint8_t result);
+    void showWinAnimation(uint8_t player);
+    void showDrawAnimation();
+    void flashPosition(Position pos, uint8_t player);
+};
 
 #endif // TIC_TAC_TOE_HPP
@@ -0,0 +1,146 @@
+#include "TicTacToeAI.hpp"
+#include "Hal.hpp"
+#include "BoardSymmetry.hpp"
+
+// Ordem de busca: centro, cantos e depois bordas
+static const uint8_t MOVE_ORDER[BitBoard::CELL_COUNT] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+static inline uint16_t tableIndex(uint32_t key) {
+    return (uint16_t)((key * 2654435761u) >> 23) & (TicTacToeAI::TT_SIZE - 1);
+}
+
+TicTacToeAI::TicTacToeAI() : nodes(0), ttHits(0) {
+    clearTable();
+}
+
+void TicTacToeAI::clearTable() {
+    for (uint16_t i = 0; i < TT_SIZE; i++) {
+        table[i].bound = BOUND_NONE;
+    }
+}
+
+int TicTacToeAI::evaluate(const BitBoard& board) {
+    if (board.checkWin(1)) return WIN_SCORE;
+    if (board.checkWin(2)) return -WIN_SCORE;
+    return 0;
+}
+
+bool TicTacToeAI::search(const BitBoard& board, uint8_t player, SearchResult& result) {
+    uint64_t start = halTimeUs();
+    uint16_t empty = board.emptyMask();
+
+    result.bestMoves = 0;
+    result.score = 0;
+    nodes = 0;
+    ttHits = 0;
+
+    if (empty == 0 || board.checkWin(1) || board.checkWin(2)) {
+        result.nodes = 0;
+        result.ttHits = 0;
+        result.timeUs = 0;
+        return false;
+    }
+
+    // Na raiz usa alfa = melhor - 1 para obter o valor exato dos empates
+    // e devolver todas as jogadas ótimas
+    BitBoard work = board;
+    int best = -WIN_SCORE - BitBoard::CELL_COUNT - 1;
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    for (uint8_t i = 0; i < BitBoard::CELL_COUNT; i++) {
+        uint8_t cell = MOVE_ORDER[i];
+        if (!(empty & (1u << cell))) continue;
+
+        work.makeMove(cell, player);
+        int score = -negamax(work, opponent, -WIN_SCORE - BitBoard::CELL_COUNT, -(best - 1));
+        work.unmakeMove(cell, player);
+
+        if (score > best) {
+            best = score;
+            result.bestMoves = 1u << cell;
+        } else if (score == best) {
+            result.bestMoves |= 1u << cell;
+        }
+    }
+
+    result.score = (int8_t)best;
+    result.nodes = nodes;
+    result.ttHits = ttHits;
+    result.timeUs = (uint32_t)(halTimeUs() - start);
+    return true;
+}
+
+// Retorna o valor da posição para 'player', que está na vez. Vitórias mais
+// rápidas valem mais: o valor depende só do número de peças no tabuleiro,
+// então as entradas da tabela continuam válidas entre buscas.
+int TicTacToeAI::negamax(BitBoard& board, uint8_t player, int alpha, int beta) {
+    nodes++;
+
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    uint8_t pieces = board.moveCount();
+    if (board.checkWin(opponent)) return -(WIN_SCORE + BitBoard::CELL_COUNT - pieces);
+    if (pieces == BitBoard::CELL_COUNT) return 0;
+
+    int originalAlpha = alpha;
+    // Posições simétricas dividem a entrada; a jogada fica guardada na
+    // forma canônica e volta para o tabuleiro real na leitura
+    CanonicalPosition position = BoardSymmetry::canonical(board);
+    uint32_t key = position.key;
+    TTEntry& entry = table[tableIndex(key)];
+    uint8_t ttMove = BitBoard::CELL_COUNT;
+
+    if (entry.bound != BOUND_NONE && entry.key == key) {
+        if (entry.move < BitBoard::CELL_COUNT)
+            ttMove = BoardSymmetry::fromCanonical(position.symmetry, entry.move);
+        if (entry.bound == BOUND_EXACT) {
+            ttHits++;
+            return entry.score;
+        }
+        if (entry.bound == BOUND_LOWER && entry.score > alpha) alpha = entry.score;
+        else if (entry.bound == BOUND_UPPER && entry.score < beta) beta = entry.score;
+        if (alpha >= beta) {
+            ttHits++;
+            return entry.score;
+        }
+    }
+
+    uint16_t empty = board.emptyMask();
+
+    // Vitória imediata encerra a busca sem descer mais
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!(empty & (1u << cell))) continue;
+        if (BitBoard::isWinningMask(board.playerMask(player) | (1u << cell))) {
+            return WIN_SCORE + BitBoard::CELL_COUNT - (pieces + 1);
+        }
+    }
+
+    int best = -WIN_SCORE - BitBoard::CELL_COUNT - 1;
+    uint8_t bestMove = BitBoard::CELL_COUNT;
+
+    for (int8_t i = -1; i < (int8_t)BitBoard::CELL_COUNT; i++) {
+        // A jogada sugerida pela tabela é tentada primeiro
+        uint8_t cell = (i < 0) ? ttMove : MOVE_ORDER[i];
+        if (cell >= BitBoard::CELL_COUNT || !(empty & (1u << cell))) continue;
+        if (i >= 0 && cell == ttMove) continue;
+
+        board.makeMove(cell, player);
+        int score = -negamax(board, opponent, -beta, -alpha);
+        board.unmakeMove(cell, player);
+
+        if (score > best) {
+            best = score;
+            bestMove = cell;
+        }
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+
+    entry.key = key;
+    entry.score = (int8_t)best;
+    entry.move = (bestMove < BitBoard::CELL_COUNT)
+        ? BoardSymmetry::toCanonical(position.symmetry, bestMove) : bestMove;
+    if (best <= originalAlpha) entry.bound = BOUND_UPPER;
+    else if (best >= beta) entry.bound = BOUND_LOWER;
+    else entry.bound = BOUND_EXACT;
+
+    return best;
+}
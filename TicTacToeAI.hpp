@@ -0,0 +1,57 @@
+#ifndef TIC_TAC_TOE_AI_HPP
+#define TIC_TAC_TOE_AI_HPP
+
+#include <stdint.h>
+#include "BitBoard.hpp"
+
+// Resultado de uma busca: todas as jogadas ótimas e as estatísticas
+typedef struct {
+    uint16_t bestMoves;  // máscara com todas as jogadas de valor ótimo
+    int8_t score;        // valor do ponto de vista de quem joga (>0 vence, <0 perde)
+    uint32_t nodes;      // nós visitados
+    uint32_t ttHits;     // cortes pela tabela de transposição
+    uint32_t timeUs;     // duração da busca
+} SearchResult;
+
+// Busca negamax com poda alfa-beta, ordenação de jogadas e tabela de
+// transposição de tamanho fixo (TT_SIZE * 8 bytes de RAM). A tabela é
+// indexada pela forma canônica da posição (BoardSymmetry), então as até 8
+// posições simétricas dividem uma entrada.
+class TicTacToeAI {
+public:
+    static const uint16_t TT_SIZE = 128;
+    static const int8_t WIN_SCORE = 10;
+
+    TicTacToeAI();
+
+    // Avalia a posição do ponto de vista da IA: +10 vitória, -10 derrota, 0 caso contrário
+    static int evaluate(const BitBoard& board);
+
+    // Procura as jogadas ótimas de 'player'. Retorna false se não há jogada.
+    bool search(const BitBoard& board, uint8_t player, SearchResult& result);
+
+    void clearTable();
+
+private:
+    enum Bound : uint8_t {
+        BOUND_NONE = 0,
+        BOUND_EXACT,
+        BOUND_LOWER,
+        BOUND_UPPER
+    };
+
+    typedef struct {
+        uint32_t key;
+        int8_t score;
+        uint8_t bound;
+        uint8_t move;
+    } TTEntry;
+
+    TTEntry table[TT_SIZE];
+    uint32_t nodes;
+    uint32_t ttHits;
+
+    int negamax(BitBoard& board, uint8_t player, int alpha, int beta);
+};
+
+#endif // TIC_TAC_TOE_AI_HPP
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include "Hal.hpp"
+#include "TicTacToeGrid.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+#include "BoardPalette.hpp"
+
+#define AI_BUDGET_US 300000  // tempo máximo de busca por jogada da IA
+#define AREA_SIZE 5          // área desenhada, no centro do painel: tabuleiro e borda
+
+static const WS2812::Color COLOR_CURSOR = WS2812::color(47, 47, 47);
+
+template <uint8_t N, uint8_t K>
+TicTacToeGrid<N, K>::TicTacToeGrid(WS2812& ledStrip, InputLayer& input)
+    : ledStrip(ledStrip), frame(ledStrip), input(input), currentPlayer(1), cursor({N / 2, N / 2}), gameActive(true)
+{
+    frame.centerArea(AREA_SIZE, AREA_SIZE);
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::run() {
+    drawBoard();
+    while (halRunning()) {
+        PROBE_SCOPE(PROBE_LOOP);
+        Event event;
+        while (eventPop(event))
+            handleEvent(event);
+        if (gameActive && currentPlayer == 1) {
+            makeAIMove();
+            drawBoard();
+            checkGameState();
+        }
+        updateTimers();
+        PROBE_STOP();
+        logFlush();
+        probePollCommands();
+        halWaitForEvent();
+    }
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::drawBoard() {
+    PROBE_SCOPE(PROBE_DRAW);
+    frame.clear(COLOR_OFF);
+
+    // Linhas e colunas da área fora do tabuleiro viram borda
+    frame.fillRect(N, 0, AREA_SIZE - N, AREA_SIZE, COLOR_GRID);
+    frame.fillRect(0, N, N, AREA_SIZE - N, COLOR_GRID);
+
+    for (uint8_t y = 0; y < N; y++)
+        for (uint8_t x = 0; x < N; x++) {
+            uint8_t cell = engine.get(x, y);
+            if (cell == 1)
+                frame.setPixel(x, y, COLOR_PLAYER1);
+            else if (cell == 2)
+                frame.setPixel(x, y, COLOR_PLAYER2);
+        }
+
+    if (gameActive && currentPlayer == 2 && engine.get(cursor.x, cursor.y) == 0)
+        frame.setPixel(cursor.x, cursor.y, input.mode() == INPUT_MIC ? COLOR_CURSOR_MIC : COLOR_CURSOR);
+
+    animator.compose(ledStrip);
+    ledStrip.show();
+    animator.frameShown();
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::interruptAnimation(uint32_t eventUs) {
+    if (!animator.isActive()) return;
+    animator.inputReceived(eventUs);
+    animator.cancel();
+    drawBoard();
+}
+
+// Entrada na vez do humano, quadros durante as animações
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::updateTimers() {
+    input.setListening(gameActive && currentPlayer == 2);
+    animator.updateFrameTimer();
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::handleEvent(const Event &event) {
+    if (input.handle(event)) {
+        InputAction action;
+        while (input.poll(action))
+            handleAction(action);
+    } else if (event.type == EVENT_TIMER && event.source == TIMER_FRAME) {
+        if (animator.advance()) drawBoard();
+    }
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::handleAction(const InputAction &action) {
+    switch (action.type) {
+    case ACTION_MOVE:
+        if (!gameActive) return;
+        cursor.x = (cursor.x + action.dx + N) % N;
+        cursor.y = (cursor.y + action.dy + N) % N;
+        drawBoard();
+        break;
+    case ACTION_NEXT:
+        nextCell();
+        break;
+    case ACTION_PLACE:
+        place(action.timeUs);
+        break;
+    case ACTION_RESET:
+        interruptAnimation(action.timeUs);
+        resetGame();
+        break;
+    case ACTION_MODE:
+        drawBoard();
+        break;
+    case ACTION_WAKE:
+        interruptAnimation(action.timeUs);
+        return;
+    }
+    probeRecord(PROBE_EVENT_LATENCY, (uint32_t)halTimeUs() - action.timeUs);
+}
+
+// Uma palma: próxima casa vazia em ordem de leitura
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::nextCell() {
+    if (!gameActive || currentPlayer != 2) return;
+    for (int i = 0; i < N * N; i++) {
+        cursor.x = (cursor.x + 1) % N;
+        if (cursor.x == 0)
+            cursor.y = (cursor.y + 1) % N;
+        if (engine.get(cursor.x, cursor.y) == 0) break;
+    }
+    drawBoard();
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::place(uint32_t eventUs) {
+    interruptAnimation(eventUs);
+    if (!gameActive) {
+        resetGame();
+    } else if (currentPlayer == 2 && engine.get(cursor.x, cursor.y) == 0) {
+        engine.makeMove(GridEngine<N, K>::cellIndex(cursor.x, cursor.y), 2);
+        drawBoard();
+        checkGameState();
+    }
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::makeAIMove() {
+    PROBE_SCOPE(PROBE_AI);
+    GridSearchResult result;
+    if (!engine.search(1, AI_BUDGET_US, result)) return;
+    engine.makeMove(result.move, 1);
+    printf("IA %ux%u: profundidade %u%s, valor %ld, %lu nós, %lu us\n", N, N, result.depth,
+           result.exact ? " (exata)" : "", (long)result.score,
+           (unsigned long)result.nodes, (unsigned long)result.timeUs);
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::checkGameState() {
+    if (engine.winner() == currentPlayer) {
+        showWinAnimation(currentPlayer);
+        gameActive = false;
+    } else if (engine.isFull()) {
+        showDrawAnimation();
+        gameActive = false;
+    } else {
+        currentPlayer = (currentPlayer == 1) ? 2 : 1;
+    }
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::resetGame() {
+    engine.clear();
+    cursor = {N / 2, N / 2};
+    currentPlayer = 1;
+    gameActive = true;
+    drawBoard();
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::showWinAnimation(uint8_t player) {
+    animator.play(WIN_FRAMES[player - 1], 5, Animator::WHOLE_STRIP);
+    drawBoard();
+}
+
+template <uint8_t N, uint8_t K>
+void TicTacToeGrid<N, K>::showDrawAnimation() {
+    animator.play(DRAW_FRAMES, 3, Animator::WHOLE_STRIP);
+    drawBoard();
+}
+
+// Variantes disponíveis na matriz 5x5
+template class TicTacToeGrid<4, 3>;
+template class TicTacToeGrid<5, 4>;
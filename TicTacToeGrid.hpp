@@ -0,0 +1,44 @@
+#ifndef TIC_TAC_TOE_GRID_HPP
+#define TIC_TAC_TOE_GRID_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+#include "FrameBuffer.hpp"
+#include "BitBoard.hpp"
+#include "GridEngine.hpp"
+#include "Animation.hpp"
+#include "Input.hpp"
+
+// Jogo N x N com K em linha. Cada casa é um LED da matriz 5x5, então o
+// tabuleiro ocupa o canto superior esquerdo sem linhas de grade.
+template <uint8_t N, uint8_t K>
+class TicTacToeGrid {
+public:
+    TicTacToeGrid(WS2812& ledStrip, InputLayer& input);
+    void run();
+
+private:
+    WS2812& ledStrip;
+    FrameBuffer frame;
+    InputLayer& input;
+    GridEngine<N, K> engine;
+    uint8_t currentPlayer;
+    Position cursor;
+    bool gameActive;
+    Animator animator;
+
+    void drawBoard();
+    void interruptAnimation(uint32_t eventUs);
+    void handleEvent(const Event &event);
+    void handleAction(const InputAction &action);
+    void nextCell();
+    void place(uint32_t eventUs);
+    void updateTimers();
+    void makeAIMove();
+    void checkGameState();
+    void resetGame();
+    void showWinAnimation(uint8_t player);
+    void showDrawAnimation();
+};
+
+#endif // TIC_TAC_TOE_GRID_HPP
@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include "Hal.hpp"
+#include "TicTacToeUltimate.hpp"
+#include "EventLog.hpp"
+#include "Probe.hpp"
+#include "BoardPicture.hpp"
+#include "BoardPalette.hpp"
+
+#define MCTS_NODE_POOL 4096     // 16 bytes por nó
+#define MCTS_TIME_US 700000     // tempo de busca por jogada
+#define MCTS_MAX_PLAYOUTS 0     // 0 = limitado só pelo tempo
+
+static const WS2812::Color COLOR_ZOOM_GRID = WS2812::color(0, 34, 34);
+static const WS2812::Color COLOR_CURSOR = WS2812::color(47, 47, 47);
+static const WS2812::Color COLOR_OPEN = WS2812::color(0, 39, 0);
+static const WS2812::Color COLOR_CLOSED = WS2812::color(34, 34, 0);
+
+// O tabuleiro ativo é sempre jogável, então entre as piscadas fica COLOR_OPEN
+static const Keyframe ACTIVE_BLINK_FRAMES[4] = {
+    {COLOR_CURSOR, 150 / ANIMATION_TICK_MS}, {COLOR_OPEN, 150 / ANIMATION_TICK_MS},
+    {COLOR_CURSOR, 150 / ANIMATION_TICK_MS}, {COLOR_OPEN, 150 / ANIMATION_TICK_MS}
+};
+
+static void drawGrid(FrameBuffer& frame, WS2812::Color color) {
+    frame.clear(COLOR_OFF);
+    BoardPicture::drawGrid(frame, color);
+}
+
+TicTacToeUltimate::TicTacToeUltimate(WS2812& ledStrip, InputLayer& input)
+    : ledStrip(ledStrip), frame(ledStrip), input(input), mcts(MCTS_NODE_POOL), cursor({1, 1}),
+      zoomedBoard(UltimateState::ANY_BOARD), zoomPending(false)
+{
+    BoardPicture::attach(frame);
+    mcts.seed((uint32_t)halTimeUs());
+}
+
+void TicTacToeUltimate::run() {
+    draw();
+    while (halRunning()) {
+        PROBE_SCOPE(PROBE_LOOP);
+        // Entradas são tratadas também durante as animações; a IA espera a
+        // animação do tabuleiro ativo terminar
+        Event event;
+        while (eventPop(event))
+            handleEvent(event);
+        if (!state.isOver() && state.toMove() == 1 && !animator.isActive() && !zoomPending) {
+            makeAIMove();
+        }
+        updateTimers();
+        PROBE_STOP();
+        logFlush();
+        probePollCommands();
+        halWaitForEvent();
+    }
+}
+
+// Visão geral: um LED por tabuleiro, 'highlight' pisca à parte
+void TicTacToeUltimate::drawOverview(int8_t highlight) {
+    drawGrid(frame, COLOR_GRID);
+    uint16_t legal = state.legalBoards();
+    for (uint8_t b = 0; b < UltimateState::BOARD_COUNT; b++) {
+        uint16_t bit = 1u << b;
+        WS2812::Color color = COLOR_OFF;
+        if (state.macroMask(1) & bit) color = COLOR_PLAYER1;
+        else if (state.macroMask(2) & bit) color = COLOR_PLAYER2;
+        else if (state.closedMask() & bit) color = COLOR_CLOSED;
+        else if (legal & bit) color = COLOR_OPEN;
+        BoardPicture::setCell(frame, b, color);
+    }
+    if (highlight != UltimateState::ANY_BOARD) BoardPicture::setCell(frame, highlight, cursorColor());
+}
+
+// Tabuleiro ampliado: grade em outra cor para diferenciar do jogo clássico
+void TicTacToeUltimate::drawZoomed() {
+    drawGrid(frame, COLOR_ZOOM_GRID);
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        uint8_t value = state.get(zoomedBoard, cell);
+        if (value == 1) BoardPicture::setCell(frame, cell, COLOR_PLAYER1);
+        else if (value == 2) BoardPicture::setCell(frame, cell, COLOR_PLAYER2);
+    }
+    uint8_t cursorCell = BitBoard::cellIndex(cursor.x, cursor.y);
+    if (state.toMove() == 2 && state.get(zoomedBoard, cursorCell) == 0)
+        BoardPicture::setCell(frame, cursorCell, cursorColor());
+}
+
+// Cor do cursor indica o modo de entrada
+WS2812::Color TicTacToeUltimate::cursorColor() const {
+    return input.mode() == INPUT_MIC ? COLOR_CURSOR_MIC : COLOR_CURSOR;
+}
+
+void TicTacToeUltimate::draw() {
+    PROBE_SCOPE(PROBE_DRAW);
+    if (zoomedBoard == UltimateState::ANY_BOARD) {
+        bool hideCursor = state.isOver() || zoomPending;
+        int8_t highlight = hideCursor ? UltimateState::ANY_BOARD : (int8_t)BitBoard::cellIndex(cursor.x, cursor.y);
+        drawOverview(highlight);
+    } else {
+        drawZoomed();
+    }
+    animator.compose(ledStrip);
+    ledStrip.show();
+    animator.frameShown();
+}
+
+// Entrada durante uma animação: cancela e aplica o que ela adiaria.
+// Retorna true se havia animação tocando.
+bool TicTacToeUltimate::interruptAnimation(uint32_t eventUs) {
+    if (!animator.isActive()) return false;
+    animator.inputReceived(eventUs);
+    animator.cancel();
+    if (zoomPending) finishZoom();
+    else draw();
+    return true;
+}
+
+void TicTacToeUltimate::updateAnimations() {
+    if (animator.advance()) {
+        if (zoomPending && !animator.isActive()) finishZoom();
+        else draw();
+    }
+}
+
+void TicTacToeUltimate::finishZoom() {
+    zoomPending = false;
+    zoomedBoard = state.activeBoard();
+    cursor = {1, 1};
+    draw();
+}
+
+// Mostra na visão geral qual tabuleiro ficou ativo e amplia se for obrigatório
+void TicTacToeUltimate::followActiveBoard() {
+    int8_t active = state.activeBoard();
+    zoomedBoard = UltimateState::ANY_BOARD;
+    cursor = {1, 1};
+    if (active != UltimateState::ANY_BOARD) {
+        zoomPending = true;
+        animator.play(ACTIVE_BLINK_FRAMES, 4, BoardPicture::cellPixel(frame, active));
+    }
+    draw();
+}
+
+// Entrada na vez do humano, quadros durante as animações
+void TicTacToeUltimate::updateTimers() {
+    input.setListening(!state.isOver() && state.toMove() == 2);
+    animator.updateFrameTimer();
+}
+
+void TicTacToeUltimate::handleEvent(const Event &event) {
+    if (input.handle(event)) {
+        InputAction action;
+        while (input.poll(action))
+            handleAction(action);
+    } else if (event.type == EVENT_TIMER && event.source == TIMER_FRAME) {
+        updateAnimations();
+    }
+}
+
+void TicTacToeUltimate::handleAction(const InputAction &action) {
+    bool humanTurn = !state.isOver() && state.toMove() == 2;
+    switch (action.type) {
+    case ACTION_MOVE: {
+        if (!humanTurn) return;
+        interruptAnimation(action.timeUs);
+        int8_t x = cursor.x + action.dx;
+        int8_t y = cursor.y + action.dy;
+        // Sair pela borda do tabuleiro ampliado por escolha volta à visão geral
+        if ((x < 0 || x > 2 || y < 0 || y > 2) && leaveFreeZoom()) break;
+        cursor.x = (x + 3) % 3;
+        cursor.y = (y + 3) % 3;
+        draw();
+        break;
+    }
+    case ACTION_NEXT:
+        nextCell();
+        break;
+    case ACTION_PLACE:
+        place(action.timeUs);
+        break;
+    case ACTION_RESET:
+        interruptAnimation(action.timeUs);
+        // Ampliado por escolha, o B só desfaz a escolha
+        if (!leaveFreeZoom()) resetGame();
+        break;
+    case ACTION_MODE:
+        draw();
+        break;
+    case ACTION_WAKE:
+        interruptAnimation(action.timeUs);
+        return;
+    }
+    probeRecord(PROBE_EVENT_LATENCY, (uint32_t)halTimeUs() - action.timeUs);
+}
+
+// Uma palma: próximo tabuleiro aberto na visão geral, ou próxima casa
+// livre no tabuleiro ampliado
+void TicTacToeUltimate::nextCell() {
+    if (state.isOver() || state.toMove() != 2 || zoomPending) return;
+    uint16_t open = (zoomedBoard == UltimateState::ANY_BOARD) ? state.legalBoards()
+                                                              : state.legalCells(zoomedBoard);
+    if (open == 0) return;
+    uint8_t index = BitBoard::cellIndex(cursor.x, cursor.y);
+    do {
+        index = (index + 1) % BitBoard::CELL_COUNT;
+    } while (!(open & (1u << index)));
+    cursor = {(uint8_t)(index % 3), (uint8_t)(index / 3)};
+    draw();
+}
+
+// Escolha livre com um tabuleiro ampliado: volta à visão geral com o
+// cursor nele. false se não havia o que desfazer
+bool TicTacToeUltimate::leaveFreeZoom() {
+    if (state.isOver() || state.toMove() != 2 || zoomPending) return false;
+    if (state.activeBoard() != UltimateState::ANY_BOARD || zoomedBoard == UltimateState::ANY_BOARD) return false;
+    cursor = {(uint8_t)(zoomedBoard % 3), (uint8_t)(zoomedBoard / 3)};
+    zoomedBoard = UltimateState::ANY_BOARD;
+    draw();
+    return true;
+}
+
+// O clique que interrompe uma animação só a encerra: o cursor acabou
+// de voltar ao centro e a jogada seria feita sem o jogador ver onde
+void TicTacToeUltimate::place(uint32_t eventUs) {
+    if (interruptAnimation(eventUs)) return;
+    bool humanTurn = !state.isOver() && state.toMove() == 2;
+    uint8_t index = BitBoard::cellIndex(cursor.x, cursor.y);
+    if (state.isOver()) {
+        resetGame();
+    } else if (humanTurn && zoomedBoard == UltimateState::ANY_BOARD) {
+        // Escolha livre: amplia o tabuleiro selecionado se estiver aberto
+        if (state.legalBoards() & (1u << index)) {
+            zoomedBoard = index;
+            cursor = {1, 1};
+            draw();
+        }
+    } else if (humanTurn && (state.legalCells(zoomedBoard) & (1u << index))) {
+        state.makeMove(zoomedBoard * 9 + index);
+        draw();
+        if (state.isOver()) showResult();
+        else followActiveBoard();
+    }
+}
+
+void TicTacToeUltimate::makeAIMove() {
+    PROBE_SCOPE(PROBE_AI);
+    MctsLimits limits = {MCTS_MAX_PLAYOUTS, MCTS_TIME_US};
+    MctsResult result;
+    if (!mcts.search(state, limits, result)) return;
+
+    // Mostra a jogada no tabuleiro em que ela foi feita
+    zoomedBoard = result.move / 9;
+    state.makeMove(result.move);
+    draw();
+    printf("MCTS: %lu simulações (%lu/s), %lu nós, %lu bytes, vitória %u/1000\n",
+           (unsigned long)result.playouts, (unsigned long)result.playoutsPerSecond,
+           (unsigned long)result.nodesUsed, (unsigned long)result.treeBytes, result.winRate);
+
+    if (state.isOver()) showResult();
+    else followActiveBoard();
+}
+
+void TicTacToeUltimate::resetGame() {
+    state.clear();
+    zoomedBoard = UltimateState::ANY_BOARD;
+    zoomPending = false;
+    cursor = {1, 1};
+    draw();
+}
+
+void TicTacToeUltimate::showResult() {
+    if (state.winner()) animator.play(WIN_FRAMES[state.winner() - 1], 5, Animator::WHOLE_STRIP);
+    else animator.play(DRAW_FRAMES, 3, Animator::WHOLE_STRIP);
+    zoomedBoard = UltimateState::ANY_BOARD;
+    draw();
+}
@@ -0,0 +1,50 @@
+#ifndef TIC_TAC_TOE_ULTIMATE_HPP
+#define TIC_TAC_TOE_ULTIMATE_HPP
+
+#include <stdint.h>
+#include "WS2812.hpp"
+#include "FrameBuffer.hpp"
+#include "BitBoard.hpp"
+#include "UltimateEngine.hpp"
+#include "Animation.hpp"
+#include "Input.hpp"
+
+// Ultimate Tic-Tac-Toe. A matriz 5x5 mostra ou a visão
+// geral (um LED por tabuleiro) ou o tabuleiro ativo ampliado. Na escolha
+// livre, o B ou o cursor saindo pela borda desfaz a ampliação.
+class TicTacToeUltimate {
+public:
+    TicTacToeUltimate(WS2812& ledStrip, InputLayer& input);
+    void run();
+
+private:
+    WS2812& ledStrip;
+    FrameBuffer frame;
+    InputLayer& input;
+    UltimateState state;
+    UltimateMcts mcts;
+    Position cursor;        // casa no tabuleiro ampliado ou tabuleiro na visão geral
+    int8_t zoomedBoard;     // tabuleiro ampliado, ou ANY_BOARD na visão geral
+    bool zoomPending;       // amplia o tabuleiro ativo quando a animação terminar
+    Animator animator;
+
+    void drawOverview(int8_t highlight);
+    void drawZoomed();
+    void draw();
+    bool interruptAnimation(uint32_t eventUs);
+    void updateAnimations();
+    void finishZoom();
+    void handleEvent(const Event &event);
+    void handleAction(const InputAction &action);
+    void nextCell();
+    void place(uint32_t eventUs);
+    bool leaveFreeZoom();
+    void updateTimers();
+    WS2812::Color cursorColor() const;
+    void makeAIMove();
+    void followActiveBoard();
+    void resetGame();
+    void showResult();
+};
+
+#endif // TIC_TAC_TOE_ULTIMATE_HPP
@@ -0,0 +1,230 @@
+#include <math.h>
+#include "UltimateEngine.hpp"
+#include "Hal.hpp"
+
+// Constante de exploração do UCT (aprox. sqrt(2))
+#define UCT_EXPLORATION 1.41f
+
+UltimateState::UltimateState() {
+    clear();
+}
+
+void UltimateState::clear() {
+    for (uint8_t b = 0; b < BOARD_COUNT; b++) {
+        masks[b][0] = 0;
+        masks[b][1] = 0;
+    }
+    macro[0] = 0;
+    macro[1] = 0;
+    closed = 0;
+    active = ANY_BOARD;
+    player = 1;
+    won = 0;
+}
+
+uint8_t UltimateState::get(uint8_t board, uint8_t cell) const {
+    uint16_t bit = 1u << cell;
+    if (masks[board][0] & bit) return 1;
+    if (masks[board][1] & bit) return 2;
+    return 0;
+}
+
+uint16_t UltimateState::legalBoards() const {
+    if (isOver()) return 0;
+    if (active != ANY_BOARD) return 1u << active;
+    return ~closed & BitBoard::FULL_MASK;
+}
+
+uint16_t UltimateState::legalCells(uint8_t board) const {
+    if (!(legalBoards() & (1u << board))) return 0;
+    return ~(masks[board][0] | masks[board][1]) & BitBoard::FULL_MASK;
+}
+
+uint8_t UltimateState::legalMoves(uint8_t* moves) const {
+    uint8_t count = 0;
+    uint16_t boards = legalBoards();
+    for (uint8_t b = 0; b < BOARD_COUNT; b++) {
+        if (!(boards & (1u << b))) continue;
+        uint16_t cells = ~(masks[b][0] | masks[b][1]) & BitBoard::FULL_MASK;
+        for (; cells; cells &= cells - 1) {
+            moves[count++] = b * 9 + __builtin_ctz(cells);
+        }
+    }
+    return count;
+}
+
+void UltimateState::makeMove(uint8_t move) {
+    uint8_t board = move / 9;
+    uint8_t cell = move % 9;
+    uint8_t p = player - 1;
+
+    masks[board][p] |= 1u << cell;
+    if (BitBoard::isWinningMask(masks[board][p])) {
+        macro[p] |= 1u << board;
+        closed |= 1u << board;
+        if (BitBoard::isWinningMask(macro[p])) won = player;
+    } else if ((masks[board][0] | masks[board][1]) == BitBoard::FULL_MASK) {
+        closed |= 1u << board;
+    }
+
+    active = (closed & (1u << cell)) ? ANY_BOARD : (int8_t)cell;
+    player = (player == 1) ? 2 : 1;
+}
+
+UltimateMcts::UltimateMcts(uint32_t capacity)
+    : nodeCapacity(capacity), nodesUsed(0), rngState(0x9E3779B9) {
+    nodes = new Node[capacity];
+}
+
+UltimateMcts::~UltimateMcts() {
+    delete[] nodes;
+}
+
+uint32_t UltimateMcts::nodeBytes() {
+    return sizeof(Node);
+}
+
+uint32_t UltimateMcts::nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Filho com maior UCT; filhos ainda não visitados têm prioridade
+uint32_t UltimateMcts::select(uint32_t parent) {
+    const Node& node = nodes[parent];
+    float logParent = logf((float)node.visits);
+    uint32_t best = node.firstChild;
+    float bestValue = -1.0f;
+
+    for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; i++) {
+        const Node& child = nodes[i];
+        if (child.visits == 0) return i;
+        float mean = child.score / (2.0f * child.visits);
+        float value = mean + UCT_EXPLORATION * sqrtf(logParent / child.visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = i;
+        }
+    }
+    return best;
+}
+
+bool UltimateMcts::expand(uint32_t index, const UltimateState& state) {
+    uint8_t moves[UltimateState::MOVE_COUNT];
+    uint8_t count = state.legalMoves(moves);
+    if (count == 0 || nodesUsed + count > nodeCapacity) return false;
+
+    nodes[index].firstChild = nodesUsed;
+    nodes[index].childCount = count;
+    for (uint8_t i = 0; i < count; i++) {
+        Node& child = nodes[nodesUsed++];
+        child.visits = 0;
+        child.score = 0;
+        child.firstChild = 0;
+        child.childCount = 0;
+        child.move = moves[i];
+    }
+    return true;
+}
+
+// Simulação aleatória até o fim; sorteia direto nas máscaras, sem lista de jogadas
+uint8_t UltimateMcts::playout(UltimateState& state) {
+    while (!state.isOver()) {
+        uint16_t boards = state.legalBoards();
+        uint8_t total = 0;
+        for (uint16_t b = boards; b; b &= b - 1) {
+            total += __builtin_popcount(state.legalCells(__builtin_ctz(b)));
+        }
+
+        uint8_t choice = nextRandom() % total;
+        for (uint16_t b = boards; b; b &= b - 1) {
+            uint8_t board = __builtin_ctz(b);
+            uint16_t cells = state.legalCells(board);
+            uint8_t count = __builtin_popcount(cells);
+            if (choice < count) {
+                while (choice--) cells &= cells - 1;
+                state.makeMove(board * 9 + __builtin_ctz(cells));
+                break;
+            }
+            choice -= count;
+        }
+    }
+    return state.winner();
+}
+
+bool UltimateMcts::search(const UltimateState& root, const MctsLimits& limits, MctsResult& result) {
+    uint64_t start = halTimeUs();
+    uint32_t playouts = 0;
+    uint32_t path[UltimateState::MOVE_COUNT + 1];
+    uint8_t rootPlayer = root.toMove();
+
+    result.move = -1;
+    result.playouts = 0;
+    result.timeUs = 0;
+    result.playoutsPerSecond = 0;
+    result.nodesUsed = 0;
+    result.treeBytes = 0;
+    result.winRate = 0;
+    if (root.isOver() || nodeCapacity == 0) return false;
+
+    nodesUsed = 1;
+    nodes[0].visits = 0;
+    nodes[0].score = 0;
+    nodes[0].firstChild = 0;
+    nodes[0].childCount = 0;
+    nodes[0].move = 0;
+
+    while (true) {
+        if (limits.playouts && playouts >= limits.playouts) break;
+        if (limits.timeUs && halTimeUs() - start >= limits.timeUs) break;
+
+        // Seleção
+        UltimateState state = root;
+        uint8_t depth = 0;
+        uint32_t index = 0;
+        path[0] = 0;
+        while (nodes[index].childCount > 0 && !state.isOver()) {
+            index = select(index);
+            state.makeMove(nodes[index].move);
+            path[++depth] = index;
+        }
+
+        // Expansão: a raiz sempre, os demais nós a partir da segunda visita
+        if (!state.isOver() && (index == 0 || nodes[index].visits > 0) && expand(index, state)) {
+            index = nodes[index].firstChild + nextRandom() % nodes[index].childCount;
+            state.makeMove(nodes[index].move);
+            path[++depth] = index;
+        }
+
+        // Simulação e retropropagação
+        uint8_t winner = playout(state);
+        for (uint8_t d = 0; d <= depth; d++) {
+            Node& node = nodes[path[d]];
+            uint8_t mover = (d % 2 == 1) ? rootPlayer : (rootPlayer == 1 ? 2 : 1);
+            node.visits++;
+            if (winner == mover) node.score += 2;
+            else if (winner == 0) node.score += 1;
+        }
+        playouts++;
+    }
+
+    // Jogada mais visitada
+    const Node& rootNode = nodes[0];
+    uint32_t bestVisits = 0;
+    for (uint32_t i = rootNode.firstChild; i < rootNode.firstChild + rootNode.childCount; i++) {
+        if (nodes[i].visits > bestVisits || result.move < 0) {
+            bestVisits = nodes[i].visits;
+            result.move = nodes[i].move;
+            result.winRate = bestVisits ? (uint16_t)(nodes[i].score * 500u / bestVisits) : 0;
+        }
+    }
+
+    result.playouts = playouts;
+    result.timeUs = (uint32_t)(halTimeUs() - start);
+    result.playoutsPerSecond = result.timeUs ? (uint32_t)((uint64_t)playouts * 1000000u / result.timeUs) : 0;
+    result.nodesUsed = nodesUsed;
+    result.treeBytes = nodesUsed * sizeof(Node);
+    return result.move >= 0;
+}
@@ -0,0 +1,94 @@
+#ifndef ULTIMATE_ENGINE_HPP
+#define ULTIMATE_ENGINE_HPP
+
+#include <stdint.h>
+#include "BitBoard.hpp"
+
+// Estado do Ultimate Tic-Tac-Toe: 3x3 tabuleiros 3x3. Jogada = tabuleiro * 9 + casa.
+// A casa jogada define o tabuleiro em que o adversário deve jogar; se ele já
+// estiver fechado (vencido ou cheio) o adversário joga em qualquer um aberto.
+class UltimateState {
+public:
+    static constexpr uint8_t BOARD_COUNT = 9;
+    static constexpr uint8_t MOVE_COUNT = 81;
+    static constexpr int8_t ANY_BOARD = -1;
+
+    UltimateState();
+    void clear();
+
+    uint8_t get(uint8_t board, uint8_t cell) const;
+    uint16_t boardMask(uint8_t board, uint8_t player) const { return masks[board][player - 1]; }
+    uint16_t macroMask(uint8_t player) const { return macro[player - 1]; }
+    uint16_t closedMask() const { return closed; }
+    int8_t activeBoard() const { return active; }
+    uint8_t toMove() const { return player; }
+    uint8_t winner() const { return won; }
+    bool isOver() const { return won != 0 || closed == BitBoard::FULL_MASK; }
+
+    // Casas livres de um tabuleiro que podem receber jogada agora
+    uint16_t legalCells(uint8_t board) const;
+    // Tabuleiros onde há jogada legal
+    uint16_t legalBoards() const;
+    uint8_t legalMoves(uint8_t* moves) const;
+
+    void makeMove(uint8_t move);
+
+private:
+    uint16_t masks[BOARD_COUNT][2];
+    uint16_t macro[2];      // tabuleiros vencidos por jogador
+    uint16_t closed;        // tabuleiros vencidos ou cheios
+    int8_t active;          // tabuleiro obrigatório ou ANY_BOARD
+    uint8_t player;         // quem joga
+    uint8_t won;            // vencedor da partida (0 = nenhum)
+};
+
+// Limites de uma busca: a primeira condição atingida encerra
+typedef struct {
+    uint32_t playouts;      // 0 = sem limite
+    uint32_t timeUs;        // 0 = sem limite
+} MctsLimits;
+
+typedef struct {
+    int8_t move;            // jogada mais visitada (-1 se não há)
+    uint32_t playouts;
+    uint32_t timeUs;
+    uint32_t playoutsPerSecond;
+    uint32_t nodesUsed;
+    uint32_t treeBytes;     // memória efetivamente usada pela árvore
+    uint16_t winRate;       // taxa de vitória estimada da jogada, em milésimos
+} MctsResult;
+
+// Monte Carlo Tree Search com UCT. Todos os nós vêm de um pool alocado no
+// construtor; quando ele acaba a árvore para de crescer e a busca continua
+// só com simulações a partir das folhas.
+class UltimateMcts {
+public:
+    UltimateMcts(uint32_t capacity);
+    ~UltimateMcts();
+
+    bool search(const UltimateState& root, const MctsLimits& limits, MctsResult& result);
+    void seed(uint32_t value) { rngState = value ? value : 1; }
+    uint32_t capacity() const { return nodeCapacity; }
+    static uint32_t nodeBytes();
+
+private:
+    typedef struct {
+        uint32_t visits;
+        uint32_t score;        // meios pontos para quem fez a jogada do nó
+        uint32_t firstChild;   // índice no pool, 0 = não expandido
+        uint8_t childCount;
+        uint8_t move;
+    } Node;
+
+    Node* nodes;
+    uint32_t nodeCapacity;
+    uint32_t nodesUsed;
+    uint32_t rngState;
+
+    uint32_t nextRandom();
+    uint32_t select(uint32_t parent);
+    bool expand(uint32_t index, const UltimateState& state);
+    uint8_t playout(UltimateState& state);
+};
+
+#endif // ULTIMATE_ENGINE_HPP
@@ -1,122 +1,204 @@
 #include "WS2812.hpp"
-#include "WS2812.pio.h"
-
-//#define DEBUG
-
-#ifdef DEBUG
+#include "Probe.hpp"
+#include <string.h>
 #include <stdio.h>
-#endif
-
-WS2812::WS2812(uint pin, uint length, PIO pio, uint sm)  {
-    initialize(pin, length, pio, sm, NONE, GREEN, RED, BLUE);
-}
-
-WS2812::WS2812(uint pin, uint length, PIO pio, uint sm, DataFormat format) {
-    switch (format) {
-        case FORMAT_RGB:
-            initialize(pin, length, pio, sm, NONE, RED, GREEN, BLUE);
-            break;
-        case FORMAT_GRB:
-            initialize(pin, length, pio, sm, NONE, GREEN, RED, BLUE);
-            break;
-        case FORMAT_WRGB:
-            initialize(pin, length, pio, sm, WHITE, RED, GREEN, BLUE);
-            break;
-    }
-}
-
-WS2812::WS2812(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3) {
-    initialize(pin, length, pio, sm, b1, b1, b2, b3);
-}
 
-WS2812::WS2812(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4) {
-    initialize(pin, length, pio, sm, b1, b2, b3, b4);
-}
+//#define DEBUG
 
-WS2812::~WS2812() {
-    
+WS2812Base::~WS2812Base() {
+    waitForFrame();
+    releaseOutput();
+    delete[] data;
+    delete[] sentData;
+    delete[] frontData;
+    delete[] planeData;
 }
 
-void WS2812::initialize(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4) {
+WS2812Base::WS2812Base(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4,
+                       uint lanes) {
     this->pin = pin;
     this->length = length;
     this->pio = pio;
     this->sm = sm;
     this->data = new uint32_t[length];
+    this->sentData = new uint32_t[length];
+    this->frontData = new uint32_t[length];
+    memset(this->data, 0, length * sizeof(uint32_t));
+    this->lanes = lanes;
+    this->planeData = nullptr;
+    this->frontValid = false;
+    this->changedFirst = 0;
+    this->changedLast = 0;
+    this->changedCount = 0;
+    resetStats();
+    this->transferActive = false;
+    this->latchUntilUs = 0;
+    this->frameDoneCallback = nullptr;
+    this->frameDoneContext = nullptr;
+    this->outputReady = false;
     this->bytes[0] = b1;
     this->bytes[1] = b2;
     this->bytes[2] = b3;
     this->bytes[3] = b4;
-    uint offset = pio_add_program(pio, &ws2812_program);
-    uint bits = (b1 == NONE ? 24 : 32);
-    #ifdef DEBUG
-    printf("WS2812 / Initializing SM %u with offset %X at pin %u and %u data bits...\n", sm, offset, pin, bits);
-    #endif
-    ws2812_program_init(pio, sm, offset, pin, 800000, bits);
-}
-
-uint32_t WS2812::convertData(uint32_t rgbw) {
-    uint32_t result = 0;
-    for (uint b = 0; b < 4; b++) {
-        switch (bytes[b]) {
-            case RED:
-                result |= (rgbw & 0xFF);
-                break;
-            case GREEN:
-                result |= (rgbw & 0xFF00) >> 8;
-                break;
-            case BLUE:
-                result |= (rgbw & 0xFF0000) >> 16;
-                break;
-            case WHITE:
-                result |= (rgbw & 0xFF000000) >> 24;
-                break;
-        }
-        result <<= 8;
-    }
-    return result;
-}
-
-void WS2812::setPixelColor(uint index, uint32_t color) {
-    if (index < length) {
-        data[index] = convertData(color);
-    }
-}
-
-void WS2812::setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue) {
-    setPixelColor(index, RGB(red, green, blue));
+    this->bits = (b1 == NONE ? 24 : 32);
+    if (lanes > 1) this->planeData = new uint32_t[wireWords()];
+    initializeOutput();
 }
 
-void WS2812::setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
-    setPixelColor(index, RGBW(red, green, blue, white));
+void WS2812Base::setFrameDoneCallback(FrameDoneCallback callback, void *context) {
+    frameDoneCallback = callback;
+    frameDoneContext = context;
 }
 
-void WS2812::fill(uint32_t color) {
+void WS2812Base::fill(Color color) {
     fill(color, 0, length);
 }
 
-void WS2812::fill(uint32_t color, uint first) {
+void WS2812Base::fill(Color color, uint first) {
     fill(color, first, length-first);
 }
 
-void WS2812::fill(uint32_t color, uint first, uint count) {
+void WS2812Base::fill(Color color, uint first, uint count) {
     uint last = (first + count);
     if (last > length) {
         last = length;
     }
-    color = convertData(color);
     for (uint i = first; i < last; i++) {
-        data[i] = color;
+        data[i] = color.word;
     }
 }
 
-void WS2812::show() {
+void WS2812Base::show() {
+    PROBE_SCOPE(PROBE_SHOW);
     #ifdef DEBUG
     for (uint i = 0; i < length; i++) {
         printf("WS2812 / Put data: %08X\n", data[i]);
     }
     #endif
+    renderStats.framesSubmitted++;
+
+    // Compara com o último quadro enviado; o DMA só lê o front, então
+    // a comparação não precisa esperar a transferência
+    uint first = 0, last = 0, count = 0;
     for (uint i = 0; i < length; i++) {
-        pio_sm_put_blocking(pio, sm, data[i]);
+        if (data[i] != sentData[i]) {
+            if (count == 0) first = i;
+            last = i;
+            count++;
+        }
+    }
+    if (frontValid && count == 0) {
+        renderStats.framesSkipped++;
+        return;
     }
-}
\ No newline at end of file
+    if (!frontValid) {
+        first = 0;
+        last = length - 1;
+        count = length;
+    }
+    changedFirst = first;
+    changedLast = last;
+    changedCount = count;
+    renderStats.pixelsChanged += count;
+    renderStats.bytesPushed += wireWords() * sizeof(uint32_t);
+
+    // O front só pode mudar depois que o quadro anterior travou
+    waitForFrame();
+    bool limited;
+    uint16_t current = prepareFront(limited);
+    if (limited) renderStats.framesLimited++;
+    renderStats.lastCurrentMa = current;
+    if (current > renderStats.peakCurrentMa) renderStats.peakCurrentMa = current;
+    startTransfer();
+}
+
+uint16_t WS2812Base::prepareFront(bool &limited) {
+    memcpy(sentData, data, length * sizeof(uint32_t));
+    frontValid = true;
+    uint16_t current = output.process(sentData, frontData, length, limited);
+    if (lanes > 1) transposeLanes(frontData, lanes, laneLength(), bits, planeData);
+    return current;
+}
+
+// Bytes de 4 palavras (a..d) em 4 palavras por posição: x[k] = a.k b.k c.k d.k,
+// com o byte 0 no topo
+static inline void transposeBytes(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t x[4]) {
+    uint32_t t0 = (a & 0xFF00FF00) | ((b >> 8) & 0x00FF00FF);
+    uint32_t t1 = ((a << 8) & 0xFF00FF00) | (b & 0x00FF00FF);
+    uint32_t t2 = (c & 0xFF00FF00) | ((d >> 8) & 0x00FF00FF);
+    uint32_t t3 = ((c << 8) & 0xFF00FF00) | (d & 0x00FF00FF);
+    x[0] = (t0 & 0xFFFF0000) | (t2 >> 16);
+    x[1] = (t1 & 0xFFFF0000) | (t3 >> 16);
+    x[2] = (t0 << 16) | (t2 & 0x0000FFFF);
+    x[3] = (t1 << 16) | (t3 & 0x0000FFFF);
+}
+
+// Matriz 8x8 de bits (Hacker's Delight, 7-3): linhas 0..3 em x e 4..7 em y,
+// linha 0 no byte alto e coluna 0 no bit 7. Só palavras de 32 bits (M0+)
+static inline void transposeBits(uint32_t &x, uint32_t &y) {
+    uint32_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+}
+
+// Linha r da matriz = fita 7 - r, então a coluna (tempo de bit) sai com a
+// fita n no bit n; as fitas que faltam entram como zero
+void WS2812Base::transposeLanes(const uint32_t *pixels, uint lanes, uint laneLength, uint bits, uint32_t *planes) {
+    uint32_t w[WS2812_MAX_LANES] = {0};
+    uint32_t high[4], low[4];
+    uint byteCount = bits / 8;
+    for (uint i = 0; i < laneLength; i++) {
+        for (uint lane = 0; lane < lanes; lane++) w[lane] = pixels[lane * laneLength + i];
+        transposeBytes(w[7], w[6], w[5], w[4], high);
+        transposeBytes(w[3], w[2], w[1], w[0], low);
+        for (uint b = 0; b < byteCount; b++) {
+            uint32_t x = high[b], y = low[b];
+            transposeBits(x, y);
+            *planes++ = x;
+            *planes++ = y;
+        }
+    }
+}
+
+void WS2812Base::setBrightness(uint8_t value) {
+    output.setBrightness(value);
+    invalidate();
+}
+
+void WS2812Base::setGammaEnabled(bool enabled) {
+    output.setGammaEnabled(enabled);
+    invalidate();
+}
+
+void WS2812Base::setPowerBudget(uint16_t milliamps) {
+    output.setPowerBudget(milliamps);
+    invalidate();
+}
+
+void WS2812Base::lastChanged(uint &first, uint &last, uint &count) const {
+    first = changedFirst;
+    last = changedLast;
+    count = changedCount;
+}
+
+void WS2812Base::invalidate() {
+    frontValid = false;
+}
+
+void WS2812Base::resetStats() {
+    memset(&renderStats, 0, sizeof(renderStats));
+}
+
+void WS2812Base::printStats() const {
+    printf("WS2812 pino %u: %lu quadros submetidos, %lu pulados, %lu pixels alterados, %llu bytes ao PIO\n",
+           pin, (unsigned long)renderStats.framesSubmitted, (unsigned long)renderStats.framesSkipped,
+           (unsigned long)renderStats.pixelsChanged, (unsigned long long)renderStats.bytesPushed);
+    printf("WS2812 pino %u: corrente %u mA (pico %u mA, orçamento %u mA), %lu quadros limitados\n",
+           pin, renderStats.lastCurrentMa, renderStats.peakCurrentMa, output.powerBudget(),
+           (unsigned long)renderStats.framesLimited);
+}
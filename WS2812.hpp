@@ -3,8 +3,18 @@
 
 #include "pico/types.h"
 #include "hardware/pio.h"
+#include "ColorPipeline.hpp"
 
-class WS2812 {
+// Blocos PIO do RP2040, com 4 máquinas de estado cada
+#define WS2812_PIO_BLOCKS 2
+#define WS2812_PIO_SMS 4
+// Fitas por máquina de estados no programa paralelo (um byte por tempo de bit)
+#define WS2812_MAX_LANES 8
+
+// Parte da fita que não depende do formato dos pixels: buffers, transporte
+// (PIO/DMA no Pico, terminal no host) e contadores. Os pixels já ficam
+// codificados no formato da fita; a codificação é feita por WS2812Basic.
+class WS2812Base {
     public:
         enum DataByte {
             NONE=0,
@@ -13,45 +23,274 @@ class WS2812 {
             BLUE=3,
             WHITE=4
         };
-        enum DataFormat {
-            FORMAT_RGB=0,
-            FORMAT_GRB=1,
-            FORMAT_WRGB=2
+
+        // Cor já codificada no formato da fita (palavra enviada ao PIO)
+        typedef struct {
+            uint32_t word;
+        } Color;
+
+        ~WS2812Base();
+
+        // Passado como 'sm' (ou pio = nullptr): o registro escolhe uma
+        // máquina de estados livre
+        static const uint ANY_SM = ~0u;
+
+        // Programas PIO: uma fita por máquina (ws2812.pio) ou até
+        // WS2812_MAX_LANES fitas em pinos consecutivos (ws2812_parallel.pio)
+        enum PioProgram {
+            PROGRAM_SERIAL = 0,
+            PROGRAM_PARALLEL,
+            PROGRAM_COUNT
         };
 
-        WS2812(uint pin, uint length, PIO pio, uint sm);
-        WS2812(uint pin, uint length, PIO pio, uint sm, DataFormat format);
-        WS2812(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3);
-        WS2812(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4);
-        ~WS2812();
+        // Registro dos blocos PIO: cada programa é carregado no primeiro uso
+        // do bloco, compartilhado pelas fitas do bloco e removido quando a
+        // última delas é destruída
+        typedef struct {
+            uint8_t strips;         // máquinas de estado em uso por fitas
+            uint8_t programLoads;   // vezes em que o programa foi carregado
+            int8_t programOffset;   // -1 = programa fora do bloco
+        } PioBlockStats;
+        static const PioBlockStats &pioBlockStats(uint block, PioProgram program = PROGRAM_SERIAL);
+
+        // false se não havia máquina de estados (ou espaço para o programa):
+        // a fita existe, mas show() não envia nada
+        bool hasOutput() const { return outputReady; }
+        PIO pioBlock() const { return pio; }
+        uint stateMachine() const { return sm; }
+        // LEDs no buffer de desenho, somando todas as fitas
+        uint ledCount() const { return length; }
+        // Fitas nesta máquina de estados e LEDs em cada uma; o buffer de
+        // desenho tem as fitas em sequência (fita 0 nos índices 0..laneLength-1)
+        uint laneCount() const { return lanes; }
+        uint laneLength() const { return length / lanes; }
+
+        // Palavras por pixel ('bits' = 24 ou 32, alinhadas no bit 31) de
+        // 'lanes' fitas em sequência para planos de bits: cada byte de saída
+        // é um tempo de bit com a fita n no bit n, quatro por palavra, na
+        // ordem em que o PIO paralelo os envia. 'planes' recebe
+        // laneLength * bits / 4 palavras. Transposição 8x8 por bit-slicing,
+        // sem laço por bit.
+        static void transposeLanes(const uint32_t *pixels, uint lanes, uint laneLength, uint bits, uint32_t *planes);
 
-        static uint32_t RGB(uint8_t red, uint8_t green, uint8_t blue) {
+        static constexpr uint32_t RGB(uint8_t red, uint8_t green, uint8_t blue) {
             return (uint32_t)(blue) << 16 | (uint32_t)(green) << 8 | (uint32_t)(red);
         };
 
-        static uint32_t RGBW(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+        static constexpr uint32_t RGBW(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
             return (uint32_t)(white) << 24 | (uint32_t)(blue) << 16 | (uint32_t)(green) << 8 | (uint32_t)(red);
         }
 
-        void setPixelColor(uint index, uint32_t color);
-        void setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue);
-        void setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white);
-        void fill(uint32_t color);
-        void fill(uint32_t color, uint first);
-        void fill(uint32_t color, uint first, uint count);
+        void setPixelColor(uint index, Color color) {
+            if (index < length) {
+                data[index] = color.word;
+            }
+        }
+        void fill(Color color);
+        void fill(Color color, uint first);
+        void fill(Color color, uint first, uint count);
+
+        // Contadores do caminho de renderização
+        typedef struct {
+            uint32_t framesSubmitted;   // chamadas a show()
+            uint32_t framesSkipped;     // iguais ao último quadro enviado
+            uint32_t pixelsChanged;     // pixels alterados, somados sobre os quadros enviados
+            uint64_t bytesPushed;       // bytes escritos na FIFO do PIO
+            uint32_t framesLimited;     // escalados pelo orçamento de corrente
+            uint16_t lastCurrentMa;     // corrente estimada do último quadro enviado
+            uint16_t peakCurrentMa;
+        } RenderStats;
+
+        // Gama, brilho e orçamento de corrente aplicados ao copiar o quadro
+        // para o buffer de envio; mudar qualquer um reenvia o próximo quadro
+        void setBrightness(uint8_t value);
+        void setGammaEnabled(bool enabled);
+        void setPowerBudget(uint16_t milliamps);
+        const ColorPipeline &pipeline() const { return output; }
+
+        // Envia o quadro por DMA e retorna logo; o desenho seguinte pode
+        // começar em seguida. Só espera se o quadro anterior (ou o intervalo
+        // de reset do WS2812) ainda não terminou. Um quadro igual ao último
+        // enviado não é reenviado. Um quadro diferente vai inteiro, porque a
+        // fita é um registrador de deslocamento e não aceita envio parcial.
         void show();
+        // Envio antigo, palavra por palavra com a CPU ocupada (para comparação)
+        void showBlocking();
+        // true enquanto o quadro enviado ainda não foi travado nos LEDs
+        bool isBusy() const;
+        void waitForFrame() const;
+
+        // Pixels que mudaram no último quadro enviado: [first, last]; count = 0 se nenhum
+        void lastChanged(uint &first, uint &last, uint &count) const;
+        // Força o próximo show() a enviar mesmo sem mudança
+        void invalidate();
+        const RenderStats &stats() const { return renderStats; }
+        void resetStats();
+        void printStats() const;
+
+        // Chamada no contexto da interrupção do DMA quando um quadro termina
+        typedef void (*FrameDoneCallback)(WS2812Base *strip, void *context);
+        void setFrameDoneCallback(FrameDoneCallback callback, void *context);
+
+    protected:
+        WS2812Base(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4,
+                   uint lanes = 1);
 
-    private:
         uint pin;
         uint length;
         PIO pio;
         uint sm;
         DataByte bytes[4];
-        uint32_t *data;
+        uint32_t *data;        // buffer de desenho (back)
+        uint32_t *sentData;    // último quadro enviado, antes do pós-processamento
+        uint32_t *frontData;   // buffer lido pelo DMA (front), já corrigido
+        uint lanes;            // fitas em pinos consecutivos (1 = programa serial)
+        uint32_t *planeData;   // front transposto em planos de bits (só com lanes > 1)
+        bool frontValid;       // sentData/frontData refletem o que os LEDs mostram
+        ColorPipeline output;
+        uint changedFirst;
+        uint changedLast;
+        uint changedCount;
+        RenderStats renderStats;
+        bool outputReady;      // máquina de estados reservada no registro
+        int dmaChannel;        // -1 = sem DMA, usa showBlocking()
+        uint bits;
+        volatile bool transferActive;
+        volatile uint64_t latchUntilUs;
+        FrameDoneCallback frameDoneCallback;
+        void *frameDoneContext;
+
+        // Transporte do quadro: PIO/DMA no Pico (WS2812Pio.cpp), terminal no host
+        bool claimStateMachine();
+        void releaseStateMachine();
+        void initializeOutput();
+        void releaseOutput();
+        void startTransfer();
+        // Empurra o front já pronto para a FIFO com a CPU (só no Pico)
+        void sendFrontBlocking();
+        static void dmaIrqHandler();
+        // Copia o back para sentData e gera o front pelo pipeline
+        uint16_t prepareFront(bool &limited);
+        // O que vai para a FIFO: o front, ou os planos de bits com várias fitas
+        const uint32_t *wireData() const { return lanes > 1 ? planeData : frontData; }
+        uint wireWords() const { return lanes > 1 ? laneLength() * bits / 4 : length; }
+        PioProgram program() const { return lanes > 1 ? PROGRAM_PARALLEL : PROGRAM_SERIAL; }
+        // Tempos de bit por palavra da FIFO (o paralelo leva 4 num byte cada)
+        uint wordBits() const { return lanes > 1 ? 4 : bits; }
+};
+
+// Ordem dos bytes na fita, resolvida em tempo de compilação. Com B1 = NONE
+// a fita tem 24 bits e B2..B4 ocupam os bits 31..8 da palavra (o PIO
+// desloca a partir do bit 31); com 32 bits B1..B4 ocupam a palavra toda.
+template <WS2812Base::DataByte B1, WS2812Base::DataByte B2, WS2812Base::DataByte B3, WS2812Base::DataByte B4>
+struct PixelFormat {
+    static constexpr WS2812Base::DataByte BYTES[4] = {B1, B2, B3, B4};
+    static constexpr uint BITS = (B1 == WS2812Base::NONE) ? 24 : 32;
 
-        void initialize(uint pin, uint length, PIO pio, uint sm, DataByte b1, DataByte b2, DataByte b3, DataByte b4);
-        uint32_t convertData(uint32_t rgbw);
+    static constexpr uint32_t channel(WS2812Base::DataByte byte, uint32_t rgbw) {
+        return byte == WS2812Base::RED   ? (rgbw & 0xFF) :
+               byte == WS2812Base::GREEN ? (rgbw >> 8) & 0xFF :
+               byte == WS2812Base::BLUE  ? (rgbw >> 16) & 0xFF :
+               byte == WS2812Base::WHITE ? (rgbw >> 24) : 0;
+    }
 
+    // Com o formato fixo vira só deslocamentos e máscaras, sem switch
+    static constexpr uint32_t encode(uint32_t rgbw) {
+        return (BITS == 24)
+            ? channel(B2, rgbw) << 24 | channel(B3, rgbw) << 16 | channel(B4, rgbw) << 8
+            : channel(B1, rgbw) << 24 | channel(B2, rgbw) << 16 | channel(B3, rgbw) << 8 | channel(B4, rgbw);
+    }
 };
 
-#endif
\ No newline at end of file
+typedef PixelFormat<WS2812Base::NONE, WS2812Base::RED, WS2812Base::GREEN, WS2812Base::BLUE> FormatRGB;
+typedef PixelFormat<WS2812Base::NONE, WS2812Base::GREEN, WS2812Base::RED, WS2812Base::BLUE> FormatGRB;
+typedef PixelFormat<WS2812Base::WHITE, WS2812Base::RED, WS2812Base::GREEN, WS2812Base::BLUE> FormatWRGB;
+
+// Fita com o formato dos pixels como parâmetro de template. Cores
+// constantes podem ser codificadas em tempo de compilação com color().
+template <class Format>
+class WS2812Basic : public WS2812Base {
+    public:
+        typedef Format PixelFormatType;
+
+        WS2812Basic(uint pin, uint length, PIO pio, uint sm)
+            : WS2812Base(pin, length, pio, sm, Format::BYTES[0], Format::BYTES[1], Format::BYTES[2], Format::BYTES[3]) {
+        }
+        // Bloco e máquina de estados escolhidos pelo registro
+        WS2812Basic(uint pin, uint length)
+            : WS2812Basic(pin, length, nullptr, ANY_SM) {
+        }
+
+        static constexpr Color color(uint8_t red, uint8_t green, uint8_t blue) {
+            return {Format::encode(RGB(red, green, blue))};
+        }
+
+        static constexpr Color color(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+            return {Format::encode(RGBW(red, green, blue, white))};
+        }
+
+        static constexpr Color encode(uint32_t rgbw) {
+            return {Format::encode(rgbw)};
+        }
+
+        using WS2812Base::setPixelColor;
+        using WS2812Base::fill;
+
+        void setPixelColor(uint index, uint32_t rgbw) {
+            setPixelColor(index, encode(rgbw));
+        }
+        void setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue) {
+            setPixelColor(index, color(red, green, blue));
+        }
+        void setPixelColor(uint index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+            setPixelColor(index, color(red, green, blue, white));
+        }
+        void fill(uint32_t rgbw) {
+            fill(encode(rgbw));
+        }
+        void fill(uint32_t rgbw, uint first) {
+            fill(encode(rgbw), first);
+        }
+        void fill(uint32_t rgbw, uint first, uint count) {
+            fill(encode(rgbw), first, count);
+        }
+
+    protected:
+        // Várias fitas em pinos consecutivos (WS2812ParallelBasic)
+        WS2812Basic(uint pin, uint length, PIO pio, uint sm, uint lanes)
+            : WS2812Base(pin, length, pio, sm, Format::BYTES[0], Format::BYTES[1], Format::BYTES[2], Format::BYTES[3],
+                         lanes) {
+        }
+};
+
+// Até WS2812_MAX_LANES fitas iguais nos pinos pin..pin + lanes - 1, numa
+// só máquina de estados: o quadro leva o tempo de uma fita, com qualquer
+// número delas. Desenha-se como numa fita só, com pixel(lane, index)
+// para achar o índice de cada fita.
+template <class Format>
+class WS2812ParallelBasic : public WS2812Basic<Format> {
+    public:
+        typedef WS2812Base::Color Color;
+
+        WS2812ParallelBasic(uint pin, uint lanes, uint laneLength, PIO pio = nullptr, uint sm = WS2812Base::ANY_SM)
+            : WS2812Basic<Format>(pin, clampLanes(lanes) * laneLength, pio, sm, clampLanes(lanes)) {
+        }
+
+        uint pixel(uint lane, uint index) const {
+            return lane * this->laneLength() + index;
+        }
+        void fillLane(uint lane, Color color) {
+            this->fill(color, pixel(lane, 0), this->laneLength());
+        }
+
+    private:
+        static constexpr uint clampLanes(uint lanes) {
+            return lanes < 1 ? 1 : lanes > WS2812_MAX_LANES ? WS2812_MAX_LANES : lanes;
+        }
+};
+
+// Formato das fitas do projeto (BitDogLab)
+typedef WS2812Basic<FormatGRB> WS2812;
+typedef WS2812ParallelBasic<FormatGRB> WS2812Parallel;
+
+#endif
@@ -0,0 +1,190 @@
+// Saída do WS2812 no Pico: programas PIO e transferência por DMA
+#include "WS2812.hpp"
+#include "WS2812.pio.h"
+#include "ws2812_parallel.pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+
+// Tempo em nível baixo que trava o quadro nos LEDs (WS2812B pede > 280 us)
+#define WS2812_RESET_US 300
+// Bits que ainda estão na FIFO (8 palavras) quando o DMA termina, a 1,25 us por bit
+#define WS2812_DRAIN_WORDS 8
+#define WS2812_BIT_NS 1250
+
+//#define DEBUG
+
+// Fitas com transferência em andamento, por canal de DMA
+static WS2812Base *dmaOwners[NUM_DMA_CHANNELS];
+
+// Registro dos blocos PIO, por programa
+static WS2812Base::PioBlockStats pioBlocks[WS2812Base::PROGRAM_COUNT][WS2812_PIO_BLOCKS] = {
+    {{0, 0, -1}, {0, 0, -1}},
+    {{0, 0, -1}, {0, 0, -1}}
+};
+static const pio_program_t *const PIO_PROGRAMS[WS2812Base::PROGRAM_COUNT] = {
+    &ws2812_program,
+    &ws2812_parallel_program
+};
+
+static PIO pioInstance(uint block) {
+    return block == 0 ? pio0 : pio1;
+}
+
+const WS2812Base::PioBlockStats &WS2812Base::pioBlockStats(uint block, PioProgram program) {
+    return pioBlocks[program][block];
+}
+
+// Reserva a máquina pedida (ou qualquer livre) no primeiro bloco que já
+// tenha o programa ou ainda tenha espaço para ele. As reservas do SDK
+// respeitam máquinas usadas por outros programas
+bool WS2812Base::claimStateMachine() {
+    const pio_program_t *pioProgram = PIO_PROGRAMS[program()];
+    for (uint block = 0; block < WS2812_PIO_BLOCKS; block++) {
+        PIO candidate = pioInstance(block);
+        if (pio != nullptr && pio != candidate) continue;
+        PioBlockStats &stats = pioBlocks[program()][block];
+        if (stats.programOffset < 0 && !pio_can_add_program(candidate, pioProgram)) continue;
+
+        int claimed = -1;
+        if (sm == ANY_SM) {
+            claimed = pio_claim_unused_sm(candidate, false);
+        } else if (sm < WS2812_PIO_SMS && !pio_sm_is_claimed(candidate, sm)) {
+            pio_sm_claim(candidate, sm);
+            claimed = (int)sm;
+        }
+        if (claimed < 0) continue;
+
+        if (stats.programOffset < 0) {
+            stats.programOffset = (int8_t)pio_add_program(candidate, pioProgram);
+            stats.programLoads++;
+        }
+        stats.strips++;
+        pio = candidate;
+        sm = (uint)claimed;
+        return true;
+    }
+    return false;
+}
+
+void WS2812Base::releaseStateMachine() {
+    PioBlockStats &stats = pioBlocks[program()][pio_get_index(pio)];
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_unclaim(pio, sm);
+    if (--stats.strips == 0) {
+        pio_remove_program(pio, PIO_PROGRAMS[program()], stats.programOffset);
+        stats.programOffset = -1;
+    }
+}
+
+void WS2812Base::initializeOutput() {
+    this->dmaChannel = -1;
+    outputReady = claimStateMachine();
+    if (!outputReady) {
+        printf("WS2812 pino %u: nenhuma máquina de estados PIO livre\n", pin);
+        return;
+    }
+    uint offset = pioBlocks[program()][pio_get_index(pio)].programOffset;
+    #ifdef DEBUG
+    printf("WS2812 / Initializing SM %u with offset %X at pin %u and %u data bits...\n", sm, offset, pin, bits);
+    #endif
+    if (lanes > 1) {
+        ws2812_parallel_program_init(pio, sm, offset, pin, lanes, 800000);
+    } else {
+        ws2812_program_init(pio, sm, offset, pin, 800000, bits);
+    }
+
+    // Canal de DMA: memória -> FIFO TX da máquina de estados, no ritmo do DREQ
+    this->dmaChannel = dma_claim_unused_channel(false);
+    if (dmaChannel >= 0) {
+        dma_channel_config c = dma_channel_get_default_config(dmaChannel);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+        dma_channel_configure(dmaChannel, &c, &pio->txf[sm], wireData(), wireWords(), false);
+
+        dmaOwners[dmaChannel] = this;
+        static bool irqInstalled = false;
+        if (!irqInstalled) {
+            irq_add_shared_handler(DMA_IRQ_0, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(DMA_IRQ_0, true);
+            irqInstalled = true;
+        }
+        dma_channel_set_irq0_enabled(dmaChannel, true);
+    }
+    #ifdef DEBUG
+    printf("WS2812 / DMA channel %d\n", dmaChannel);
+    #endif
+}
+
+void WS2812Base::releaseOutput() {
+    if (!outputReady) return;
+    if (dmaChannel >= 0) {
+        dma_channel_set_irq0_enabled(dmaChannel, false);
+        dmaOwners[dmaChannel] = nullptr;
+        dma_channel_unclaim(dmaChannel);
+    }
+    releaseStateMachine();
+    outputReady = false;
+}
+
+// Fim do DMA: os últimos bits ainda saem da FIFO, depois vem o reset
+void WS2812Base::dmaIrqHandler() {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        WS2812Base *strip = dmaOwners[ch];
+        if (strip == nullptr || !dma_channel_get_irq0_status(ch)) continue;
+        dma_channel_acknowledge_irq0(ch);
+        uint32_t drainUs = (WS2812_DRAIN_WORDS * strip->wordBits() * WS2812_BIT_NS) / 1000;
+        strip->latchUntilUs = time_us_64() + drainUs + WS2812_RESET_US;
+        strip->transferActive = false;
+        if (strip->frameDoneCallback) {
+            strip->frameDoneCallback(strip, strip->frameDoneContext);
+        }
+    }
+}
+
+bool WS2812Base::isBusy() const {
+    return transferActive || time_us_64() < latchUntilUs;
+}
+
+void WS2812Base::waitForFrame() const {
+    while (isBusy()) {
+        tight_loop_contents();
+    }
+}
+
+// Envia o front; sem canal de DMA cai no envio bloqueante
+void WS2812Base::startTransfer() {
+    if (!outputReady) return;
+    if (dmaChannel < 0) {
+        sendFrontBlocking();
+        return;
+    }
+    transferActive = true;
+    dma_channel_transfer_from_buffer_now(dmaChannel, wireData(), wireWords());
+}
+
+void WS2812Base::showBlocking() {
+    waitForFrame();
+    // Mesmo pipeline do show(); mantém sentData para a comparação
+    bool limited;
+    prepareFront(limited);
+    sendFrontBlocking();
+}
+
+// Só o envio: o front já saiu de prepareFront(), em show() ou showBlocking()
+void WS2812Base::sendFrontBlocking() {
+    waitForFrame();
+    if (!outputReady) return;
+    const uint32_t *words = wireData();
+    for (uint i = 0; i < wireWords(); i++) {
+        pio_sm_put_blocking(pio, sm, words[i]);
+    }
+    // Espera a FIFO esvaziar e o reset, como no caminho por DMA
+    while (!pio_sm_is_tx_fifo_empty(pio, sm)) {
+        tight_loop_contents();
+    }
+    latchUntilUs = time_us_64() + (wordBits() * WS2812_BIT_NS) / 1000 + WS2812_RESET_US;
+}
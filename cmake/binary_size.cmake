@@ -0,0 +1,63 @@
+# Relatório de tamanho do binário por seção e maiores símbolos, executado
+# após a compilação:
+#   cmake -DNM=<nm> -DELF=<binário> [-DTOP=<n>] -P binary_size.cmake
+# Código e constantes (text + rodata) ficam na flash; data ocupa flash e
+# RAM; bss só RAM.
+
+if (NOT TOP)
+    set(TOP 10)
+endif()
+
+execute_process(
+    COMMAND ${NM} --print-size --size-sort --radix=d -C ${ELF}
+    OUTPUT_VARIABLE nm_output
+    RESULT_VARIABLE nm_result
+)
+if (NOT nm_result EQUAL 0)
+    message(WARNING "nm falhou em ${ELF}")
+    return()
+endif()
+
+set(text 0)
+set(rodata 0)
+set(data 0)
+set(bss 0)
+set(symbols "")
+string(REPLACE "\n" ";" nm_lines "${nm_output}")
+foreach(line ${nm_lines})
+    if (NOT line MATCHES "^[0-9]+ ([0-9]+) ([A-Za-z]) (.*)$")
+        continue()
+    endif()
+    math(EXPR size "${CMAKE_MATCH_1}")
+    set(type ${CMAKE_MATCH_2})
+    set(name "${CMAKE_MATCH_3}")
+    if (type MATCHES "^[TtWw]$")
+        math(EXPR text "${text} + ${size}")
+    elseif (type MATCHES "^[Rr]$")
+        math(EXPR rodata "${rodata} + ${size}")
+    elseif (type MATCHES "^[DdGg]$")
+        math(EXPR data "${data} + ${size}")
+    elseif (type MATCHES "^[BbSs]$")
+        math(EXPR bss "${bss} + ${size}")
+    else()
+        continue()
+    endif()
+    # A saída vem em ordem crescente: os maiores ficam no fim
+    list(APPEND symbols "${size} ${type} ${name}")
+endforeach()
+
+math(EXPR flash "${text} + ${rodata} + ${data}")
+math(EXPR ram "${data} + ${bss}")
+get_filename_component(elf_name ${ELF} NAME)
+message(STATUS "${elf_name}: text ${text}, rodata ${rodata}, data ${data}, bss ${bss} bytes"
+               " (flash ${flash}, RAM ${ram})")
+
+list(LENGTH symbols count)
+if (count GREATER TOP)
+    math(EXPR first "${count} - ${TOP}")
+    list(SUBLIST symbols ${first} ${TOP} symbols)
+endif()
+list(REVERSE symbols)
+foreach(entry ${symbols})
+    message(STATUS "  ${entry}")
+endforeach()
@@ -0,0 +1,27 @@
+# Relatório de tamanho de símbolos, executado após a compilação:
+#   cmake -DNM=<nm> -DELF=<binário> -DSYMBOLS="A;B" -P symbol_size.cmake
+
+execute_process(
+    COMMAND ${NM} --print-size --size-sort --radix=d ${ELF}
+    OUTPUT_VARIABLE nm_output
+    RESULT_VARIABLE nm_result
+)
+if (NOT nm_result EQUAL 0)
+    message(WARNING "nm falhou em ${ELF}")
+    return()
+endif()
+
+string(REPLACE "\n" ";" nm_lines "${nm_output}")
+foreach(symbol ${SYMBOLS})
+    set(found FALSE)
+    foreach(line ${nm_lines})
+        if (line MATCHES "^[0-9]+ ([0-9]+) ([A-Za-z]) ${symbol}$")
+            math(EXPR size "${CMAKE_MATCH_1}")
+            message(STATUS "${symbol}: ${size} bytes (seção ${CMAKE_MATCH_2})")
+            set(found TRUE)
+        endif()
+    endforeach()
+    if (NOT found)
+        message(STATUS "${symbol}: não encontrado")
+    endif()
+endforeach()
@@ -0,0 +1,54 @@
+// ADC no simulador: amostra os valores do roteiro na taxa pedida, entrada a entrada
+#include "AdcSampler.hpp"
+#include "Hal.hpp"
+
+AdcSampler::AdcSampler(uint32_t inputCount, uint32_t sampleRateHz)
+    : inputCount(inputCount), rateHz(sampleRateHz), dmaChannel(-1), startUs(0),
+      readIndex{0, 0, 0, 0}, wrapBase(0), overrunCount(0), running(false) {
+}
+
+AdcSampler::~AdcSampler() {
+    stop();
+}
+
+void AdcSampler::start() {
+    startUs = halTimeUs();
+    for (uint32_t i = 0; i < MAX_INPUTS; i++) readIndex[i] = 0;
+    running = true;
+}
+
+void AdcSampler::stop() {
+    running = false;
+}
+
+uint64_t AdcSampler::totalCaptured() const {
+    if (!running) return 0;
+    return (halTimeUs() - startUs) * rateHz * inputCount / 1000000;
+}
+
+uint16_t AdcSampler::sampleAt(uint32_t input, uint64_t sample) const {
+    return halAdcSampleAt(input, sampleTimeUs(sample));
+}
+
+uint16_t AdcSampler::latest(uint32_t input) {
+    uint64_t captured = samplesCaptured(input);
+    return captured ? sampleAt(input, captured - 1) : 0;
+}
+
+uint32_t AdcSampler::read(uint32_t input, uint16_t *out, uint32_t maxCount) {
+    if (!running || input >= inputCount) return 0;
+
+    uint64_t captured = samplesCaptured(input);
+    uint64_t depth = RING_SAMPLES / inputCount;
+    if (captured - readIndex[input] > depth - depth / 8) {
+        overrunCount++;
+        readIndex[input] = captured - depth / 2;
+    }
+
+    uint32_t count = 0;
+    while (readIndex[input] < captured && count < maxCount) {
+        out[count++] = sampleAt(input, readIndex[input]);
+        readIndex[input]++;
+    }
+    return count;
+}
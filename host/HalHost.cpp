@@ -0,0 +1,503 @@
+// HAL do simulador: relógio virtual, entradas lidas de um roteiro e
+// matriz de LEDs desenhada no terminal.
+//
+// Variáveis de ambiente:
+//   TICTACTOE_SCRIPT   arquivo de roteiro (sem ele o jogo roda 5 s sem entrada)
+//   TICTACTOE_RUN_MS   duração simulada sem roteiro, em ms (padrão 5000)
+//   TICTACTOE_REALTIME 1 = sleeps reais; padrão: sleeps só avançam o relógio
+//   TICTACTOE_RENDER   ansi, text ou none (padrão: ansi em terminal, text fora)
+//   TICTACTOE_FLASH    arquivo da flash simulada (partidas gravadas); sem ele
+//                      a flash fica só em memória e começa apagada
+//   TICTACTOE_STDIN    1 = halConsoleRead também lê o stdin real, como o USB
+//                      CDC do Pico (modo stream); o fim do stdin encerra a
+//                      simulação. Use com TICTACTOE_REALTIME=1
+//
+// Roteiro, uma linha por evento, tempo em ms desde o boot:
+//   <ms> press <pino|joystick|b>     botão em nível baixo
+//   <ms> release <pino|joystick|b>
+//   <ms> joy <left|right|up|down|center>
+//   <ms> adc <entrada> <valor>
+//   <ms> clap [duração ms]           pulso no microfone (ADC 2), padrão 30 ms
+//   <ms> key <caractere>             caractere recebido pelo stdio
+//   <ms> end                         encerra a simulação
+#include "Hal.hpp"
+#include "EventQueue.hpp"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#define GPIO_COUNT 30
+#define ADC_COUNT 5
+#define ADC_CENTER 2048
+#define ADC_MAX 4095
+#define CLAP_PULSE_MS 30
+#define DEFAULT_RUN_MS 5000
+#define SCRIPT_TAIL_MS 2000   // tempo simulado após o último evento
+
+#define FLASH_SIZE (2u * 1024 * 1024)   // mesma flash do Pico W
+
+#define JOYSTICK_BUTTON_PIN 22
+#define BUTTON_B_PIN 5
+
+typedef enum {
+    EVENT_GPIO,
+    EVENT_ADC,
+    EVENT_KEY,
+    EVENT_END
+} EventKind;
+
+typedef struct {
+    uint64_t timeUs;
+    EventKind kind;
+    uint32_t target;
+    uint16_t value;
+} ScriptEvent;
+
+typedef struct {
+    bool active;
+    bool repeat;
+    uint8_t type;
+    uint64_t periodUs;
+    uint64_t nextUs;
+} HostTimer;
+
+typedef enum {
+    RENDER_NONE,
+    RENDER_TEXT,
+    RENDER_ANSI
+} RenderMode;
+
+static std::vector<ScriptEvent> events;
+static size_t nextEvent = 0;
+static uint64_t endTimeUs = (uint64_t)DEFAULT_RUN_MS * 1000;
+static bool gpioLevel[GPIO_COUNT];
+static uint16_t adcValue[ADC_COUNT];
+static uint32_t adcSelected = 0;
+static bool realtime = false;
+static RenderMode renderMode = RENDER_TEXT;
+static uint64_t virtualOffsetUs = 0;
+static std::chrono::steady_clock::time_point startTime;
+static uint32_t framesShown = 0;
+static bool initialized = false;
+static std::vector<char> consoleInput;
+static bool consoleStdin = false;
+static bool gpioEvents[GPIO_COUNT];
+static HostTimer timers[EVENT_TIMER_SLOTS];
+static uint64_t idleUs = 0;
+static std::vector<uint8_t> flash;
+static std::vector<uint32_t> flashErases;
+static FILE *flashFile = nullptr;
+static int32_t flashBudget = -1;      // bytes até a queda de energia; -1 = sem queda
+
+static int parsePin(const char *name) {
+    if (strcmp(name, "joystick") == 0) return JOYSTICK_BUTTON_PIN;
+    if (strcmp(name, "b") == 0) return BUTTON_B_PIN;
+    return atoi(name);
+}
+
+static void addEvent(uint64_t ms, EventKind kind, uint32_t target, uint16_t value) {
+    events.push_back({ms * 1000, kind, target, value});
+}
+
+static bool loadScript(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "HAL: não foi possível abrir o roteiro %s\n", path);
+        return false;
+    }
+
+    char line[128];
+    unsigned lineNumber = 0;
+    uint64_t lastMs = 0;
+    bool hasEnd = false;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        unsigned long long ms;
+        char command[16], arg1[16] = "", arg2[16] = "";
+        int fields = sscanf(line, "%llu %15s %15s %15s", &ms, command, arg1, arg2);
+        if (fields <= 0) continue;
+        if (fields < 2) {
+            fprintf(stderr, "HAL: linha %u inválida no roteiro\n", lineNumber);
+            continue;
+        }
+
+        if (strcmp(command, "press") == 0) {
+            addEvent(ms, EVENT_GPIO, parsePin(arg1), 0);
+        } else if (strcmp(command, "release") == 0) {
+            addEvent(ms, EVENT_GPIO, parsePin(arg1), 1);
+        } else if (strcmp(command, "adc") == 0) {
+            addEvent(ms, EVENT_ADC, atoi(arg1), atoi(arg2));
+        } else if (strcmp(command, "clap") == 0) {
+            uint32_t width = (fields >= 3) ? atoi(arg1) : CLAP_PULSE_MS;
+            addEvent(ms, EVENT_ADC, 2, ADC_MAX);
+            addEvent(ms + width, EVENT_ADC, 2, 0);
+        } else if (strcmp(command, "joy") == 0) {
+            // Mesma convenção do jogo: ADC 1 move em x, ADC 0 move em y
+            uint16_t x = ADC_CENTER, y = ADC_CENTER;
+            if (strcmp(arg1, "right") == 0) y = 0;
+            else if (strcmp(arg1, "left") == 0) y = ADC_MAX;
+            else if (strcmp(arg1, "up") == 0) x = 0;
+            else if (strcmp(arg1, "down") == 0) x = ADC_MAX;
+            addEvent(ms, EVENT_ADC, 0, x);
+            addEvent(ms, EVENT_ADC, 1, y);
+        } else if (strcmp(command, "key") == 0 && arg1[0]) {
+            addEvent(ms, EVENT_KEY, 0, (uint8_t)arg1[0]);
+        } else if (strcmp(command, "end") == 0) {
+            addEvent(ms, EVENT_END, 0, 0);
+            hasEnd = true;
+        } else {
+            fprintf(stderr, "HAL: comando '%s' desconhecido na linha %u\n", command, lineNumber);
+            continue;
+        }
+        if (ms > lastMs) lastMs = ms;
+    }
+    fclose(file);
+
+    std::stable_sort(events.begin(), events.end(),
+        [](const ScriptEvent &a, const ScriptEvent &b) { return a.timeUs < b.timeUs; });
+    if (!hasEnd) addEvent(lastMs + SCRIPT_TAIL_MS, EVENT_END, 0, 0);
+    endTimeUs = UINT64_MAX;
+    return true;
+}
+
+static uint64_t nowUs() {
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + virtualOffsetUs;
+}
+
+// Aplica os eventos do roteiro cujo instante já passou e dispara os
+// alarmes vencidos; as bordas e alarmes vão para a fila com o instante
+// em que aconteceriam, não o da simulação
+static void applyDueEvents() {
+    uint64_t now = nowUs();
+    while (nextEvent < events.size() && events[nextEvent].timeUs <= now) {
+        const ScriptEvent &event = events[nextEvent++];
+        switch (event.kind) {
+            case EVENT_GPIO:
+                if (event.target >= GPIO_COUNT) break;
+                if (gpioEvents[event.target] && gpioLevel[event.target] != (event.value != 0)) {
+                    eventPost(event.value ? EVENT_GPIO_RISE : EVENT_GPIO_FALL, event.target, (uint32_t)event.timeUs);
+                }
+                gpioLevel[event.target] = event.value != 0;
+                break;
+            case EVENT_ADC:
+                if (event.target < ADC_COUNT) adcValue[event.target] = event.value;
+                break;
+            case EVENT_KEY:
+                consoleInput.push_back((char)event.value);
+                break;
+            case EVENT_END:
+                endTimeUs = event.timeUs;
+                break;
+        }
+    }
+
+    for (uint32_t id = 0; id < EVENT_TIMER_SLOTS; id++) {
+        HostTimer &timer = timers[id];
+        if (!timer.active || timer.nextUs > now) continue;
+        eventPost((EventType)timer.type, id, (uint32_t)timer.nextUs);
+        if (!timer.repeat) {
+            timer.active = false;
+            continue;
+        }
+        // Como um alarme atrasado no Pico: dispara uma vez e segue o período
+        while (timer.nextUs <= now) timer.nextUs += timer.periodUs;
+    }
+}
+
+static void printSummary() {
+    fprintf(stderr, "HAL: %lu quadros, %.3f s simulados\n",
+            (unsigned long)framesShown, nowUs() / 1e6);
+}
+
+void halInit() {
+    if (initialized) return;
+    initialized = true;
+    startTime = std::chrono::steady_clock::now();
+
+    // Entradas com pull-up em nível alto, joystick centrado, microfone em silêncio
+    for (uint32_t i = 0; i < GPIO_COUNT; i++) gpioLevel[i] = true;
+    adcValue[0] = ADC_CENTER;
+    adcValue[1] = ADC_CENTER;
+
+    const char *value = getenv("TICTACTOE_REALTIME");
+    realtime = value && strcmp(value, "1") == 0;
+
+    renderMode = isatty(STDOUT_FILENO) ? RENDER_ANSI : RENDER_TEXT;
+    value = getenv("TICTACTOE_RENDER");
+    if (value) {
+        if (strcmp(value, "none") == 0) renderMode = RENDER_NONE;
+        else if (strcmp(value, "text") == 0) renderMode = RENDER_TEXT;
+        else if (strcmp(value, "ansi") == 0) renderMode = RENDER_ANSI;
+    }
+
+    value = getenv("TICTACTOE_STDIN");
+    consoleStdin = value && strcmp(value, "1") == 0;
+    if (consoleStdin) fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+
+    value = getenv("TICTACTOE_RUN_MS");
+    if (value) endTimeUs = strtoull(value, nullptr, 10) * 1000;
+
+    value = getenv("TICTACTOE_SCRIPT");
+    if (value && !loadScript(value)) exit(1);
+
+    value = getenv("TICTACTOE_FLASH");
+    if (value && !halFlashAttach(value)) exit(1);
+
+    atexit(printSummary);
+    applyDueEvents();
+}
+
+bool halRunning() {
+    halInit();
+    applyDueEvents();
+    return nowUs() < endTimeUs;
+}
+
+uint64_t halTimeUs() {
+    if (!initialized) halInit();
+    return nowUs();
+}
+
+uint32_t halTimeMs() {
+    return (uint32_t)(halTimeUs() / 1000);
+}
+
+void halSleepUs(uint32_t us) {
+    if (realtime) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    } else {
+        virtualOffsetUs += us;
+    }
+    applyDueEvents();
+}
+
+void halSleepMs(uint32_t ms) {
+    halSleepUs(ms * 1000);
+}
+
+void halGpioInitInput(uint32_t pin, bool pullUp) {
+    (void)pin;
+    (void)pullUp;
+}
+
+bool halGpioGet(uint32_t pin) {
+    applyDueEvents();
+    return pin < GPIO_COUNT ? gpioLevel[pin] : true;
+}
+
+void halAdcInit() {
+}
+
+void halAdcGpioInit(uint32_t pin) {
+    (void)pin;
+}
+
+void halAdcSelect(uint32_t input) {
+    adcSelected = input;
+}
+
+uint16_t halAdcRead() {
+    applyDueEvents();
+    return adcSelected < ADC_COUNT ? adcValue[adcSelected] : 0;
+}
+
+int halConsoleRead() {
+    applyDueEvents();
+    if (consoleInput.empty() && consoleStdin) {
+        uint8_t c;
+        ssize_t n = read(STDIN_FILENO, &c, 1);
+        if (n == 1) return c;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            consoleStdin = false;
+            endTimeUs = nowUs();
+        }
+        return -1;
+    }
+    if (consoleInput.empty()) return -1;
+    int c = (uint8_t)consoleInput.front();
+    consoleInput.erase(consoleInput.begin());
+    return c;
+}
+
+void halGpioEnableEvents(uint32_t pin) {
+    if (pin < GPIO_COUNT) gpioEvents[pin] = true;
+}
+
+void halTimerStart(uint32_t id, uint8_t type, uint32_t periodUs, bool repeat) {
+    if (id >= EVENT_TIMER_SLOTS) return;
+    timers[id] = {true, repeat, type, periodUs ? periodUs : 1, halTimeUs() + periodUs};
+}
+
+void halTimerStop(uint32_t id) {
+    if (id < EVENT_TIMER_SLOTS) timers[id].active = false;
+}
+
+bool halTimerActive(uint32_t id) {
+    return id < EVENT_TIMER_SLOTS && timers[id].active;
+}
+
+// Sem fila: avança o relógio até o próximo evento do roteiro ou alarme
+void halWaitForEvent() {
+    applyDueEvents();
+    if (eventPending()) return;
+
+    uint64_t now = nowUs();
+    uint64_t due = endTimeUs;
+    if (nextEvent < events.size()) due = std::min(due, events[nextEvent].timeUs);
+    for (uint32_t id = 0; id < EVENT_TIMER_SLOTS; id++) {
+        if (timers[id].active) due = std::min(due, timers[id].nextUs);
+    }
+    if (due > now) {
+        idleUs += due - now;
+        halSleepUs((uint32_t)std::min<uint64_t>(due - now, UINT32_MAX));
+    }
+}
+
+uint64_t halIdleUs() {
+    return idleUs;
+}
+
+// Consultas em ordem crescente de tempo por entrada: cada uma guarda a
+// posição no roteiro e o valor corrente
+uint16_t halAdcSampleAt(uint32_t input, uint64_t timeUs) {
+    static size_t position[ADC_COUNT];
+    static uint16_t value[ADC_COUNT] = {ADC_CENTER, ADC_CENTER, 0, 0, 0};
+    static uint64_t lastTimeUs[ADC_COUNT];
+    if (input >= ADC_COUNT) return 0;
+
+    // Volta no tempo: recomeça do início do roteiro
+    if (timeUs < lastTimeUs[input]) {
+        position[input] = 0;
+        value[input] = (input < 2) ? ADC_CENTER : 0;
+    }
+    lastTimeUs[input] = timeUs;
+
+    while (position[input] < events.size() && events[position[input]].timeUs <= timeUs) {
+        const ScriptEvent &event = events[position[input]++];
+        if (event.kind == EVENT_ADC && event.target == input) value[input] = event.value;
+    }
+    return value[input];
+}
+
+static void flashInit() {
+    if (!flash.empty()) return;
+    flash.assign(FLASH_SIZE, 0xFF);
+    flashErases.assign(FLASH_SIZE / HAL_FLASH_SECTOR_SIZE, 0);
+}
+
+// Espelha no arquivo o trecho alterado
+static void flashStore(uint32_t offset, uint32_t length) {
+    if (!flashFile) return;
+    fseek(flashFile, offset, SEEK_SET);
+    fwrite(&flash[offset], 1, length, flashFile);
+    fflush(flashFile);
+}
+
+bool halFlashAttach(const char *path) {
+    if (flashFile) fclose(flashFile);
+    flashFile = nullptr;
+    flash.clear();
+    flashInit();
+    if (!path) return true;
+
+    flashFile = fopen(path, "r+b");
+    if (!flashFile) flashFile = fopen(path, "w+b");
+    if (!flashFile) {
+        fprintf(stderr, "HAL: não foi possível abrir a flash %s\n", path);
+        return false;
+    }
+    size_t length = fread(flash.data(), 1, FLASH_SIZE, flashFile);
+    // Arquivo novo ou curto: o resto fica apagado
+    if (length < FLASH_SIZE) flashStore(length, FLASH_SIZE - length);
+    return true;
+}
+
+void halFlashPowerCut(int32_t bytes) {
+    flashBudget = bytes;
+}
+
+uint32_t halFlashEraseCount(uint32_t sectorOffset) {
+    flashInit();
+    return flashErases[sectorOffset / HAL_FLASH_SECTOR_SIZE];
+}
+
+uint32_t halFlashSize() {
+    return FLASH_SIZE;
+}
+
+const uint8_t *halFlashRead(uint32_t offset) {
+    flashInit();
+    return &flash[offset];
+}
+
+// Sem energia nada muda; um apagamento conta como um byte do orçamento
+void halFlashErase(uint32_t sectorOffset) {
+    flashInit();
+    sectorOffset &= ~(HAL_FLASH_SECTOR_SIZE - 1);
+    if (flashBudget == 0) return;
+    if (flashBudget > 0) flashBudget--;
+    memset(&flash[sectorOffset], 0xFF, HAL_FLASH_SECTOR_SIZE);
+    flashErases[sectorOffset / HAL_FLASH_SECTOR_SIZE]++;
+    flashStore(sectorOffset, HAL_FLASH_SECTOR_SIZE);
+}
+
+// Só os bytes diferentes de 0xFF gastam o orçamento
+void halFlashProgram(uint32_t pageOffset, const uint8_t *page) {
+    flashInit();
+    pageOffset &= ~(HAL_FLASH_PAGE_SIZE - 1);
+    for (uint32_t i = 0; i < HAL_FLASH_PAGE_SIZE; i++) {
+        if (page[i] == 0xFF) continue;
+        if (flashBudget == 0) break;
+        if (flashBudget > 0) flashBudget--;
+        flash[pageOffset + i] &= page[i];
+    }
+    flashStore(pageOffset, HAL_FLASH_PAGE_SIZE);
+}
+
+// Desenha a fita como matriz quadrada quando possível (5x5 no BitDogLab)
+void halLedShow(uint32_t pin, const uint32_t *rgb, uint32_t length) {
+    framesShown++;
+    if (renderMode == RENDER_NONE) return;
+
+    uint32_t width = length;
+    for (uint32_t w = 1; w * w <= length; w++) {
+        if (w * w == length) width = w;
+    }
+
+    printf("[%8.3f s] LEDs no pino %u\n", nowUs() / 1e6, pin);
+    // Mesma orientação de gridIndices: linha 0 em cima
+    for (uint32_t row = 0; row < length / width; row++) {
+        for (uint32_t col = 0; col < width; col++) {
+            uint32_t color = rgb[row * width + col];
+            uint8_t r = color & 0xFF, g = (color >> 8) & 0xFF, b = (color >> 16) & 0xFF;
+            if (renderMode == RENDER_ANSI) {
+                // Os valores usados no jogo são baixos (até ~30): realça para o terminal
+                int rr = std::min(255, r * 8), gg = std::min(255, g * 8), bb = std::min(255, b * 8);
+                printf("\x1b[48;2;%d;%d;%dm  \x1b[0m", rr, gg, bb);
+            } else {
+                char symbol = '.';
+                if (r || g || b) {
+                    if (r >= g && r >= b) symbol = (g > r / 2) ? 'Y' : (b > r / 2) ? 'M' : 'R';
+                    else if (g >= b) symbol = 'G';
+                    else symbol = 'B';
+                    if (r == g && g == b) symbol = 'W';
+                }
+                printf("%c ", symbol);
+            }
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,131 @@
+// Saída do WS2812 no simulador: cada quadro vai para halLedShow(). A fita
+// fica ocupada no relógio da HAL pelo tempo que o quadro levaria no fio,
+// como no Pico, e as máquinas de estado saem do mesmo registro por bloco.
+// Várias fitas numa máquina saem dos planos de bits, desfeitos bit a bit,
+// uma chamada de halLedShow() por pino.
+#include "WS2812.hpp"
+#include "Hal.hpp"
+#include <string.h>
+#include <stdio.h>
+#include <vector>
+
+#define WS2812_RESET_US 300
+#define WS2812_BIT_NS 1250
+
+pio_hw_t hostPio[2] = {{0}, {1}};
+
+// Registro dos blocos PIO, por programa; as máquinas reservadas ficam numa máscara
+static WS2812Base::PioBlockStats pioBlocks[WS2812Base::PROGRAM_COUNT][WS2812_PIO_BLOCKS] = {
+    {{0, 0, -1}, {0, 0, -1}},
+    {{0, 0, -1}, {0, 0, -1}}
+};
+static uint8_t claimedSms[WS2812_PIO_BLOCKS];
+
+const WS2812Base::PioBlockStats &WS2812Base::pioBlockStats(uint block, PioProgram program) {
+    return pioBlocks[program][block];
+}
+
+bool WS2812Base::claimStateMachine() {
+    for (uint block = 0; block < WS2812_PIO_BLOCKS; block++) {
+        PIO candidate = &hostPio[block];
+        if (pio != nullptr && pio != candidate) continue;
+
+        int claimed = -1;
+        for (uint i = 0; i < WS2812_PIO_SMS && claimed < 0; i++) {
+            if ((sm == ANY_SM || sm == i) && !(claimedSms[block] & (1u << i))) claimed = (int)i;
+        }
+        if (claimed < 0) continue;
+
+        PioBlockStats &stats = pioBlocks[program()][block];
+        claimedSms[block] |= 1u << claimed;
+        if (stats.programOffset < 0) {
+            stats.programOffset = 0;
+            stats.programLoads++;
+        }
+        stats.strips++;
+        pio = candidate;
+        sm = (uint)claimed;
+        return true;
+    }
+    return false;
+}
+
+void WS2812Base::releaseStateMachine() {
+    PioBlockStats &stats = pioBlocks[program()][pio->index];
+    claimedSms[pio->index] &= ~(1u << sm);
+    if (--stats.strips == 0) stats.programOffset = -1;
+}
+
+void WS2812Base::initializeOutput() {
+    dmaChannel = -1;
+    outputReady = claimStateMachine();
+    if (!outputReady) printf("WS2812 pino %u: nenhuma máquina de estados PIO livre\n", pin);
+}
+
+void WS2812Base::releaseOutput() {
+    if (!outputReady) return;
+    releaseStateMachine();
+    outputReady = false;
+}
+
+bool WS2812Base::isBusy() const {
+    return halTimeUs() < latchUntilUs;
+}
+
+void WS2812Base::waitForFrame() const {
+    uint64_t now = halTimeUs();
+    if (now < latchUntilUs) halSleepUs((uint32_t)(latchUntilUs - now));
+}
+
+// Palavra no formato da fita de volta para RGB
+static uint32_t decodeWord(uint32_t word, uint bits, const WS2812Base::DataByte bytes[4]) {
+    uint32_t color = 0;
+    for (uint b = 0; b < 4; b++) {
+        // 24 bits: bytes 1..3 nos bits 31..8; 32 bits: bytes 0..3 na palavra toda
+        uint shift = (bits == 24) ? 8 * (4 - b) : 8 * (3 - b);
+        if (shift > 24) continue;
+        uint32_t value = (word >> shift) & 0xFF;
+        switch (bytes[b]) {
+            case WS2812Base::RED:   color |= value; break;
+            case WS2812Base::GREEN: color |= value << 8; break;
+            case WS2812Base::BLUE:  color |= value << 16; break;
+            case WS2812Base::WHITE: color |= value << 24; break;
+            case WS2812Base::NONE:  break;
+        }
+    }
+    return color;
+}
+
+void WS2812Base::startTransfer() {
+    if (!outputReady) return;
+    uint laneLeds = laneLength();
+    std::vector<uint32_t> rgb(laneLeds);
+    for (uint lane = 0; lane < lanes; lane++) {
+        for (uint i = 0; i < laneLeds; i++) {
+            uint32_t word = frontData[i];
+            if (lanes > 1) {
+                // Tempo de bit t no byte t % 4 (a partir do topo) da palavra t / 4
+                word = 0;
+                const uint32_t *planes = planeData + i * bits / 4;
+                for (uint t = 0; t < bits; t++) {
+                    uint32_t slot = (planes[t / 4] >> (24 - 8 * (t % 4))) & 0xFF;
+                    word |= ((slot >> lane) & 1) << (31 - t);
+                }
+            }
+            rgb[i] = decodeWord(word, bits, bytes);
+        }
+        halLedShow(pin + lane, rgb.data(), laneLeds);
+    }
+    // As fitas de uma máquina saem juntas: o tempo é o de uma delas
+    latchUntilUs = halTimeUs() + ((uint64_t)laneLength() * bits * WS2812_BIT_NS) / 1000 + WS2812_RESET_US;
+    if (frameDoneCallback) {
+        frameDoneCallback(this, frameDoneContext);
+    }
+}
+
+void WS2812Base::showBlocking() {
+    waitForFrame();
+    bool limited;
+    prepareFront(limited);
+    startTransfer();
+}
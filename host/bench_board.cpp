@@ -0,0 +1,99 @@
+// Compara verificações por segundo do BitBoard com o tabuleiro em matriz
+// (implementação original de checkWin/isBoardFull).
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include "BitBoard.hpp"
+
+#define POSITION_COUNT 4096
+#define ROUNDS 2000
+
+static bool legacyCheckWin(const uint8_t board[3][3], uint8_t player) {
+    for (uint8_t i = 0; i < 3; i++) {
+        if (board[i][0] == player && board[i][1] == player && board[i][2] == player) return true;
+        if (board[0][i] == player && board[1][i] == player && board[2][i] == player) return true;
+    }
+    if (board[0][0] == player && board[1][1] == player && board[2][2] == player) return true;
+    if (board[0][2] == player && board[1][1] == player && board[2][0] == player) return true;
+    return false;
+}
+
+static bool legacyIsBoardFull(const uint8_t board[3][3]) {
+    for (uint8_t y = 0; y < 3; y++)
+        for (uint8_t x = 0; x < 3; x++)
+            if (board[y][x] == 0) return false;
+    return true;
+}
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint8_t legacyBoards[POSITION_COUNT][3][3];
+static BitBoard bitBoards[POSITION_COUNT];
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    // Gera posições aleatórias idênticas para as duas representações
+    for (int i = 0; i < POSITION_COUNT; i++) {
+        for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+            uint8_t value = nextRandom() % 3;
+            legacyBoards[i][cell / 3][cell % 3] = value;
+            if (value != 0) bitBoards[i].makeMove(cell, value);
+        }
+    }
+
+    // Confere que as duas implementações concordam
+    for (int i = 0; i < POSITION_COUNT; i++) {
+        for (uint8_t player = 1; player <= 2; player++) {
+            if (legacyCheckWin(legacyBoards[i], player) != bitBoards[i].checkWin(player)) {
+                printf("Divergência em checkWin na posição %d\n", i);
+                return 1;
+            }
+        }
+        if (legacyIsBoardFull(legacyBoards[i]) != bitBoards[i].isFull()) {
+            printf("Divergência em isBoardFull na posição %d\n", i);
+            return 1;
+        }
+    }
+
+    const double checks = (double)POSITION_COUNT * ROUNDS * 3;
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        uint32_t hits = 0;
+        for (int i = 0; i < POSITION_COUNT; i++) {
+            hits += legacyCheckWin(legacyBoards[i], 1);
+            hits += legacyCheckWin(legacyBoards[i], 2);
+            hits += legacyIsBoardFull(legacyBoards[i]);
+        }
+        sink = sink + hits;
+    }
+    double legacySeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        uint32_t hits = 0;
+        for (int i = 0; i < POSITION_COUNT; i++) {
+            hits += bitBoards[i].checkWin(1);
+            hits += bitBoards[i].checkWin(2);
+            hits += bitBoards[i].isFull();
+        }
+        sink = sink + hits;
+    }
+    double bitSeconds = secondsSince(start);
+
+    printf("matriz 3x3: %.1f M verificações/s\n", checks / legacySeconds / 1e6);
+    printf("bitboard:   %.1f M verificações/s\n", checks / bitSeconds / 1e6);
+    printf("ganho:      %.2fx\n", legacySeconds / bitSeconds);
+    return sink == 0xFFFFFFFF;
+}
@@ -0,0 +1,138 @@
+// Várias placas IA x IA em fitas próprias: confere o registro dos blocos
+// PIO (um programa por bloco, uma máquina de estados por fita) e mede
+// quadros/s e latência por placa com show() adiado contra show() bloqueante,
+// para fitas curtas (matriz 5x5) e longas, onde o envio de um quadro passa
+// do intervalo entre quadros-chave das animações. Com show() bloqueante o
+// laço perde ticks (coluna ticks/s): as animações ficam mais lentas e a
+// espera aparece como latência das outras placas, não da própria.
+#include <stdio.h>
+#include <stdlib.h>
+#include "Hal.hpp"
+#include "WS2812.hpp"
+#include "BoardScheduler.hpp"
+
+#define RUN_MS 5000
+#define FIRST_PIN 2
+#define SHORT_LEDS 25           // matriz 5x5: ~1 ms no fio por quadro
+#define LONG_LEDS 4000          // ~120 ms por quadro, mais que um quadro-chave
+
+static uint32_t failures = 0;
+
+static void fail(const char *what, uint32_t value) {
+    printf("falha: %s (%lu)\n", what, (unsigned long)value);
+    failures++;
+}
+
+static void checkBlocks(const char *what, uint8_t strips, int8_t offset, uint8_t loads) {
+    for (uint block = 0; block < WS2812_PIO_BLOCKS; block++) {
+        const WS2812Base::PioBlockStats &stats = WS2812Base::pioBlockStats(block);
+        if (stats.strips != strips || (stats.programOffset < 0) != (offset < 0) || stats.programLoads != loads)
+            fail(what, block);
+    }
+}
+
+// 'loads' = cargas do programa esperadas em cada bloco depois desta rodada
+static void registry(uint length, uint8_t loads) {
+    WS2812 *strips[SCHEDULER_MAX_BOARDS + 1];
+    for (uint i = 0; i < SCHEDULER_MAX_BOARDS; i++) {
+        strips[i] = new WS2812(FIRST_PIN + i, length);
+        if (!strips[i]->hasOutput()) fail("fita sem máquina de estados", i);
+    }
+    checkBlocks("blocos cheios", WS2812_PIO_SMS, 0, loads);
+
+    // Nona fita: sem máquina livre, existe mas não envia
+    strips[SCHEDULER_MAX_BOARDS] = new WS2812(FIRST_PIN + SCHEDULER_MAX_BOARDS, length);
+    if (strips[SCHEDULER_MAX_BOARDS]->hasOutput()) fail("nona fita com saída", length);
+    strips[SCHEDULER_MAX_BOARDS]->show();
+
+    // Liberar uma máquina a devolve ao registro sem recarregar o programa
+    PIO pio = strips[3]->pioBlock();
+    uint sm = strips[3]->stateMachine();
+    delete strips[3];
+    strips[3] = new WS2812(FIRST_PIN + 3, length, pio, sm);
+    if (!strips[3]->hasOutput() || strips[3]->stateMachine() != sm) fail("máquina liberada", sm);
+    checkBlocks("reuso da máquina", WS2812_PIO_SMS, 0, loads);
+
+    for (uint i = 0; i <= SCHEDULER_MAX_BOARDS; i++) delete strips[i];
+    checkBlocks("programa removido com a última fita", 0, -1, loads);
+}
+
+// Latência média e máxima de um grupo de placas
+typedef struct {
+    uint32_t frames;
+    uint64_t totalUs;
+    uint32_t maxUs;
+} Latency;
+
+static void addLatency(Latency &latency, const BoardStats &s) {
+    latency.frames += s.frames;
+    latency.totalUs += s.totalLatencyUs;
+    if (s.maxLatencyUs > latency.maxUs) latency.maxUs = s.maxLatencyUs;
+}
+
+static void measure(WS2812 *strips[], const char *name, uint8_t boards, bool blocking) {
+    static const PlayerKind KINDS[3] = {PLAYER_TABLE, PLAYER_NEGAMAX, PLAYER_RANDOM};
+    BoardScheduler scheduler;
+    for (uint8_t i = 0; i < boards; i++) {
+        strips[i]->invalidate();
+        if (!scheduler.addBoard(*strips[i], KINDS[i % 3], KINDS[(i + 1) % 3])) fail("addBoard", i);
+    }
+    scheduler.setBlockingShow(blocking);
+    scheduler.run(RUN_MS);
+
+    uint32_t deferred = 0;
+    Latency first = {0, 0, 0}, others = {0, 0, 0};
+    for (uint8_t i = 0; i < boards; i++) {
+        const BoardStats &s = scheduler.stats(i);
+        if (s.frames == 0) fail("placa parada", i);
+        deferred += s.deferred;
+        addLatency(i == 0 ? first : others, s);
+    }
+    double seconds = scheduler.elapsedUs() / 1e6;
+    printf("%-6s %6u  %-11s %7.1f %9.1f %8lu %8lu %8lu", name, boards, blocking ? "bloqueante" : "adiado",
+           scheduler.tickCount() / seconds, (first.frames + others.frames) / seconds / boards,
+           (unsigned long)deferred, (unsigned long)(first.totalUs / first.frames), (unsigned long)first.maxUs);
+    if (others.frames) {
+        printf(" %8lu %8lu\n", (unsigned long)(others.totalUs / others.frames), (unsigned long)others.maxUs);
+    } else {
+        printf("        -        -\n");
+    }
+}
+
+// Fitas de um cenário: a placa 0 em 'firstLength' LEDs, as outras em 'length'
+static void scenario(const char *name, uint firstLength, uint length, uint8_t minBoards) {
+    WS2812 *strips[SCHEDULER_MAX_BOARDS];
+    for (uint i = 0; i < SCHEDULER_MAX_BOARDS; i++) strips[i] = new WS2812(FIRST_PIN + i, i == 0 ? firstLength : length);
+    const uint8_t counts[] = {1, 2, 4, 8};
+    for (uint c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        if (counts[c] < minBoards) continue;
+        measure(strips, name, counts[c], false);
+        measure(strips, name, counts[c], true);
+    }
+    for (uint i = 0; i < SCHEDULER_MAX_BOARDS; i++) delete strips[i];
+}
+
+int main() {
+    // Sem roteiro: o relógio simulado corre até o fim das medidas
+    setenv("TICTACTOE_RENDER", "none", 1);
+    setenv("TICTACTOE_RUN_MS", "100000000", 1);
+    halInit();
+
+    const uint lengths[] = {SHORT_LEDS, LONG_LEDS};
+    for (uint l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) registry(lengths[l], l + 1);
+    for (uint block = 0; block < WS2812_PIO_BLOCKS; block++) {
+        const WS2812Base::PioBlockStats &stats = WS2812Base::pioBlockStats(block);
+        printf("PIO%u: programa carregado %u vezes em %u ciclos de 8 fitas\n", block, stats.programLoads,
+               (unsigned)(sizeof(lengths) / sizeof(lengths[0])));
+    }
+
+    printf("\n%d s simulados por medida; latências em us, da mudança do quadro ao início do envio\n", RUN_MS / 1000);
+    printf("fitas  placas  show        ticks/s  quadros/s  adiados  placa 0 méd/máx    demais méd/máx\n");
+    scenario("curtas", SHORT_LEDS, SHORT_LEDS, 1);
+    scenario("longas", LONG_LEDS, LONG_LEDS, 1);
+    // Só a placa 0 numa fita longa: com show() bloqueante ela atrasa as outras
+    scenario("mista", LONG_LEDS, SHORT_LEDS, 2);
+
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
@@ -0,0 +1,132 @@
+// Custo por quadro do pós-processamento de cores (gama, brilho e orçamento
+// de corrente) somado à codificação nova, comparado ao caminho antigo, que
+// só codificava com convertData. Também confere o limitador de corrente.
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include "WS2812.hpp"
+#include "ColorPipeline.hpp"
+
+#define PIXEL_COUNT 25
+#define FRAME_COUNT 256
+#define ROUNDS 4000
+#define BUDGET_MA 500
+
+// Implementação original, fora de linha como era em WS2812.cpp
+struct LegacyEncoder {
+    WS2812Base::DataByte bytes[4];
+
+    __attribute__((noinline)) uint32_t convertData(uint32_t rgbw) const {
+        uint32_t result = 0;
+        for (uint b = 0; b < 4; b++) {
+            switch (bytes[b]) {
+                case WS2812Base::RED:
+                    result |= (rgbw & 0xFF);
+                    break;
+                case WS2812Base::GREEN:
+                    result |= (rgbw & 0xFF00) >> 8;
+                    break;
+                case WS2812Base::BLUE:
+                    result |= (rgbw & 0xFF0000) >> 16;
+                    break;
+                case WS2812Base::WHITE:
+                    result |= (rgbw & 0xFF000000) >> 24;
+                    break;
+                default:
+                    break;
+            }
+            result <<= 8;
+        }
+        return result;
+    }
+};
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint32_t frames[FRAME_COUNT][PIXEL_COUNT];
+static uint32_t back[PIXEL_COUNT];
+static uint32_t front[PIXEL_COUNT];
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    // Quadros parecidos com os do jogo: maioria apagada, alguns pixels acesos
+    for (int f = 0; f < FRAME_COUNT; f++) {
+        for (int i = 0; i < PIXEL_COUNT; i++) {
+            frames[f][i] = (nextRandom() % 3 == 0) ? nextRandom() & 0x00FFFFFF : 0;
+        }
+    }
+
+    // Limitador: tudo branco no máximo passa de 1 A e deve cair no orçamento
+    ColorPipeline limiter;
+    limiter.setPowerBudget(BUDGET_MA);
+    for (int i = 0; i < PIXEL_COUNT; i++) back[i] = FormatGRB::encode(WS2812::RGB(255, 255, 255));
+    uint32_t before = ColorPipeline::estimateMilliamps(back, PIXEL_COUNT);
+    bool limited;
+    uint16_t after = limiter.process(back, front, PIXEL_COUNT, limited);
+    printf("branco total: %lu mA estimados, %u mA depois do limitador\n", (unsigned long)before, after);
+    if (!limited || after > BUDGET_MA) {
+        printf("Limitador não respeitou o orçamento de %u mA\n", BUDGET_MA);
+        return 1;
+    }
+
+    // Brilho e gama não podem ultrapassar o valor de entrada nem sair de ordem
+    ColorPipeline dim;
+    dim.setBrightness(128);
+    for (uint32_t v = 1; v < 256; v++) {
+        uint32_t a = v << 24, b = (v - 1) << 24, outA, outB;
+        dim.process(&a, &outA, 1, limited);
+        dim.process(&b, &outB, 1, limited);
+        if (outA < outB || outA > a) {
+            printf("Curva não monotônica em %lu\n", (unsigned long)v);
+            return 1;
+        }
+    }
+
+    LegacyEncoder grb = {{WS2812Base::NONE, WS2812Base::GREEN, WS2812Base::RED, WS2812Base::BLUE}};
+    ColorPipeline pipeline;
+    pipeline.setBrightness(200);
+    pipeline.setPowerBudget(BUDGET_MA);
+    const double frameCount = (double)FRAME_COUNT * ROUNDS;
+    volatile uint32_t sink = 0;
+
+    // Antes: setPixelColor com convertData para cada pixel e cópia para o front
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int f = 0; f < FRAME_COUNT; f++) {
+            for (int i = 0; i < PIXEL_COUNT; i++) back[i] = grb.convertData(frames[f][i]);
+            memcpy(front, back, sizeof(front));
+            sink = sink + front[f % PIXEL_COUNT];
+        }
+    }
+    double legacySeconds = secondsSince(start);
+
+    // Agora: codificação em linha e pipeline completo ao gerar o front
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int f = 0; f < FRAME_COUNT; f++) {
+            for (int i = 0; i < PIXEL_COUNT; i++) back[i] = FormatGRB::encode(frames[f][i]);
+            sink = sink + pipeline.process(back, front, PIXEL_COUNT, limited);
+            sink = sink + front[f % PIXEL_COUNT];
+        }
+    }
+    double pipelineSeconds = secondsSince(start);
+
+    printf("convertData + cópia:       %.1f ns/quadro\n", legacySeconds / frameCount * 1e9);
+    printf("encode + gama/brilho/mA:   %.1f ns/quadro\n", pipelineSeconds / frameCount * 1e9);
+    if (pipelineSeconds > legacySeconds) {
+        printf("Pipeline mais caro que o caminho antigo\n");
+        return 1;
+    }
+    return sink == 0xFFFFFFFF;
+}
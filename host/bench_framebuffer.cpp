@@ -0,0 +1,197 @@
+// Geometria dos painéis e FrameBuffer: confere as tabelas de índices geradas
+// na compilação contra o caminho do fio LED a LED, confere que o mesmo
+// desenho sai igual em qualquer ordem de fio e mede quanto custa compor um
+// quadro inteiro (grade, peças, sprite e texto) pela tabela e calculando
+// o índice pixel a pixel.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+#include "Hal.hpp"
+#include "WS2812.hpp"
+#include "FrameBuffer.hpp"
+#include "BoardPicture.hpp"
+
+#define ROUNDS 200000
+#define PIN 2
+
+// Tabelas prontas na compilação
+static_assert(MatrixLayout<5, 5>::TABLE.indices[7] == 7, "5x5 em linhas");
+static_assert(MatrixLayout<8, 8, WIRING_SERPENTINE>::TABLE.indices[8] == 15, "serpentina: linha 1 volta");
+static_assert(MatrixLayout<8, 8, WIRING_SERPENTINE, ROTATE_180>::TABLE.indices[0] == 56, "180 graus: começa no fim");
+static_assert(MatrixLayout<16, 8, WIRING_ROW_MAJOR, ROTATE_90>::WIDTH == 8, "90 graus troca largura e altura");
+
+static uint32_t failures = 0;
+
+static void fail(const char *what, uint32_t value) {
+    if (failures < 10) printf("falha: %s (%lu)\n", what, (unsigned long)value);
+    failures++;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Acesso ao buffer de desenho da fita
+class PeekStrip : public WS2812 {
+public:
+    PeekStrip(uint length) : WS2812(PIN, length) {}
+    uint32_t pixel(uint index) const { return data[index]; }
+};
+
+// Referência: percorre o fio LED a LED, acha a posição no painel e desfaz o
+// giro para chegar ao (x, y) do desenho
+static void checkTable(const char *name, const MatrixGeometry &geometry, uint8_t panelWidth, uint8_t panelHeight,
+                       bool serpentine, uint8_t rotation) {
+    uint count = panelWidth * panelHeight;
+    std::vector<bool> seen(count, false);
+    for (uint wire = 0; wire < count; wire++) {
+        uint py = wire / panelWidth, px = wire % panelWidth;
+        if (serpentine && (py & 1)) px = panelWidth - 1 - px;
+        uint x = px, y = py;
+        switch (rotation) {
+            case ROTATE_90:  x = panelHeight - 1 - py; y = px; break;
+            case ROTATE_180: x = panelWidth - 1 - px; y = panelHeight - 1 - py; break;
+            case ROTATE_270: x = py; y = panelWidth - 1 - px; break;
+        }
+        if (x >= geometry.width || y >= geometry.height || geometry.indices[y * geometry.width + x] != wire) {
+            fail(name, wire);
+            return;
+        }
+        seen[wire] = true;
+    }
+    for (uint wire = 0; wire < count; wire++)
+        if (!seen[wire]) fail(name, wire);
+}
+
+static const uint8_t SPRITE_PIXELS[16] = {
+    1, 0, 0, 1,
+    0, 2, 2, 0,
+    0, 2, 2, 0,
+    1, 0, 0, 1
+};
+static const WS2812::Color SPRITE_PALETTE[2] = {WS2812::color(40, 0, 0), WS2812::color(0, 40, 0)};
+static const Sprite SPRITE = {4, 4, SPRITE_PIXELS, SPRITE_PALETTE};
+static const WS2812::Color COLOR_GRID = WS2812::color(28, 28, 0);
+static const WS2812::Color COLOR_PIECE = WS2812::color(97, 0, 0);
+static const WS2812::Color COLOR_TEXT = WS2812::color(0, 0, 60);
+static const WS2812::Color COLOR_OFF = WS2812::color(0, 0, 0);
+
+// Quadro típico: tabuleiro no centro, sprite num canto e texto embaixo
+static void compose(FrameBuffer &frame) {
+    frame.setOrigin(0, 0);
+    frame.clear(COLOR_OFF);
+    frame.centerArea(BoardPicture::SIZE, BoardPicture::SIZE);
+    BoardPicture::drawGrid(frame, COLOR_GRID);
+    for (uint8_t cell = 0; cell < 9; cell += 2) BoardPicture::setCell(frame, cell, COLOR_PIECE);
+    frame.setOrigin(0, 0);
+    frame.blit(SPRITE, -1, -1);
+    frame.drawText("12", frame.width() - 7, frame.height() - 5, COLOR_TEXT);
+}
+
+// O mesmo quadro calculando o índice de cada pixel (divisões, serpentina e
+// giro em tempo de execução), como seria sem a tabela
+struct NaivePanel {
+    PeekStrip &strip;
+    uint8_t panelWidth, panelHeight, width, height;
+    bool serpentine;
+    uint8_t rotation;
+
+    __attribute__((noinline)) void set(int x, int y, WS2812::Color color) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return;
+        int px = x, py = y;
+        switch (rotation) {
+            case ROTATE_90:  px = y; py = panelHeight - 1 - x; break;
+            case ROTATE_180: px = panelWidth - 1 - x; py = panelHeight - 1 - y; break;
+            case ROTATE_270: px = panelWidth - 1 - y; py = x; break;
+        }
+        if (serpentine && (py & 1)) px = panelWidth - 1 - px;
+        strip.setPixelColor(py * panelWidth + px, color);
+    }
+
+    void compose() {
+        strip.fill(COLOR_OFF);
+        int ox = (width - 5) / 2, oy = (height - 5) / 2;
+        for (int i = 0; i < 5; i++) {
+            set(ox + 1, oy + i, COLOR_GRID);
+            set(ox + 3, oy + i, COLOR_GRID);
+            set(ox + i, oy + 1, COLOR_GRID);
+            set(ox + i, oy + 3, COLOR_GRID);
+        }
+        for (int cell = 0; cell < 9; cell += 2) set(ox + 2 * (cell % 3), oy + 2 * (cell / 3), COLOR_PIECE);
+        for (int y = 0; y < SPRITE.height; y++)
+            for (int x = 0; x < SPRITE.width; x++)
+                if (SPRITE.pixels[y * SPRITE.width + x]) set(x - 1, y - 1, SPRITE.palette[SPRITE.pixels[y * SPRITE.width + x] - 1]);
+        // Texto: só o custo, os glifos são os mesmos da FrameBuffer
+        for (int y = 0; y < 5; y++)
+            for (int x = 0; x < 7; x++)
+                if ((x + y) & 1) set(width - 7 + x, height - 5 + y, COLOR_TEXT);
+    }
+};
+
+template <class Layout>
+static void measure(const char *name, bool serpentine, uint8_t rotation, uint8_t panelWidth, uint8_t panelHeight) {
+    const MatrixGeometry geometry = Layout::geometry();
+    checkTable(name, geometry, panelWidth, panelHeight, serpentine, rotation);
+
+    // Mesmo desenho na ordem do fio e em linhas: cada (x, y) com a mesma cor
+    PeekStrip strip(Layout::LED_COUNT), reference(Layout::LED_COUNT);
+    FrameBuffer frame(strip, geometry);
+    MatrixGeometry rowMajor = {geometry.width, geometry.height, nullptr};
+    std::vector<uint16_t> identity(Layout::LED_COUNT);
+    for (uint i = 0; i < Layout::LED_COUNT; i++) identity[i] = i;
+    rowMajor.indices = identity.data();
+    FrameBuffer plain(reference, rowMajor);
+    compose(frame);
+    compose(plain);
+    for (uint y = 0; y < geometry.height; y++)
+        for (uint x = 0; x < geometry.width; x++)
+            if (strip.pixel(geometry.indices[y * geometry.width + x]) != reference.pixel(y * geometry.width + x))
+                fail(name, y * geometry.width + x);
+
+    // Recorte: retângulo maior que o painel cobre tudo, texto e sprite fora
+    // do painel não mexem em nada
+    frame.setOrigin(0, 0);
+    frame.fillRect(-3, -3, 300, 300, COLOR_GRID);
+    frame.drawText("FORA", geometry.width, 0, COLOR_PIECE);
+    frame.blit(SPRITE, -SPRITE.width, geometry.height);
+    for (uint i = 0; i < Layout::LED_COUNT; i++)
+        if (strip.pixel(i) != COLOR_GRID.word) fail(name, i);
+
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        compose(frame);
+        sink = sink + strip.pixel(r % Layout::LED_COUNT);
+    }
+    double tableSeconds = secondsSince(start);
+
+    NaivePanel naive = {strip, panelWidth, panelHeight, geometry.width, geometry.height, serpentine, rotation};
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        naive.compose();
+        sink = sink + strip.pixel(r % Layout::LED_COUNT);
+    }
+    double naiveSeconds = secondsSince(start);
+
+    printf("%-28s %5u LEDs  tabela %7.3f us/quadro  calculado %7.3f us/quadro  %4u bytes de tabela\n", name,
+           Layout::LED_COUNT, tableSeconds / ROUNDS * 1e6, naiveSeconds / ROUNDS * 1e6,
+           (unsigned)sizeof(Layout::TABLE));
+    if (sink == 0xFFFFFFFF) printf("\n");
+}
+
+int main() {
+    setenv("TICTACTOE_RENDER", "none", 1);
+    halInit();
+
+    measure<MatrixLayout<5, 5>>("5x5 linhas (BitDogLab)", false, ROTATE_0, 5, 5);
+    measure<MatrixLayout<8, 8, WIRING_SERPENTINE>>("8x8 serpentina", true, ROTATE_0, 8, 8);
+    measure<MatrixLayout<8, 8, WIRING_ROW_MAJOR, ROTATE_180>>("8x8 linhas, 180 graus", false, ROTATE_180, 8, 8);
+    measure<MatrixLayout<16, 16, WIRING_SERPENTINE>>("16x16 serpentina", true, ROTATE_0, 16, 16);
+    measure<MatrixLayout<16, 16, WIRING_SERPENTINE, ROTATE_90>>("16x16 serpentina, 90 graus", true, ROTATE_90, 16, 16);
+    measure<MatrixLayout<16, 8, WIRING_SERPENTINE, ROTATE_270>>("16x8 serpentina, 270 graus", true, ROTATE_270, 16, 8);
+
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
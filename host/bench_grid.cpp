@@ -0,0 +1,86 @@
+// Motor N x N: confere GridEngine<3, 3> contra a tabela resolvida e mede
+// profundidade, nós por segundo e estouro de orçamento em 4x4 e 5x5.
+#include <stdio.h>
+#include <stdint.h>
+#include "BitBoard.hpp"
+#include "GridEngine.hpp"
+#include "SolvedTable.hpp"
+
+#define BUDGET_US 200000
+#define GAMES 2
+
+typedef GridEngine<3, 3> Grid3x3Engine;
+
+static uint32_t checked = 0;
+static uint32_t mismatches = 0;
+
+// Percorre as posições 3x3 com a IA na vez e compara com a tabela
+static void walk3x3(Grid3x3Engine& engine, BitBoard& board, uint8_t player) {
+    if (board.checkWin(1) || board.checkWin(2) || board.isFull()) return;
+
+    if (player == 1) {
+        GridSearchResult result;
+        engine.search(1, 10000000, result);
+        uint16_t entry = solvedLookup(board);
+        int8_t expected = solvedScore(entry);
+        int8_t sign = (result.score > 0) - (result.score < 0);
+        int8_t expectedSign = (expected > 0) - (expected < 0);
+        checked++;
+        if (!result.exact || sign != expectedSign || !(solvedBestMoves(entry) & (1u << result.move))) {
+            mismatches++;
+        }
+    }
+
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        engine.makeMove(cell, player);
+        walk3x3(engine, board, opponent);
+        engine.unmakeMove(cell, player);
+        board.unmakeMove(cell, player);
+    }
+}
+
+// IA contra IA com orçamento fixo por jogada
+template <uint8_t N, uint8_t K>
+static void selfPlay() {
+    GridEngine<N, K> engine;
+    uint32_t moves = 0, worstUs = 0, depthSum = 0;
+    uint64_t nodes = 0, timeUs = 0;
+    uint8_t results[3] = {0, 0, 0};
+
+    for (int game = 0; game < GAMES; game++) {
+        engine.clear();
+        uint8_t player = 1;
+        while (engine.winner() == 0 && !engine.isFull()) {
+            GridSearchResult result;
+            engine.search(player, BUDGET_US, result);
+            engine.makeMove(result.move, player);
+            moves++;
+            nodes += result.nodes;
+            timeUs += result.timeUs;
+            depthSum += result.depth;
+            if (result.timeUs > worstUs) worstUs = result.timeUs;
+            player = (player == 1) ? 2 : 1;
+        }
+        results[engine.winner()]++;
+    }
+
+    printf("%ux%u, %u em linha: %u jogos (IA1 %u, IA2 %u, empates %u)\n", N, N, K, GAMES,
+           results[1], results[2], results[0]);
+    printf("  profundidade média %.1f, %.0f nós/s, pior jogada %lu us (orçamento %u us)\n",
+           (double)depthSum / moves, nodes * 1e6 / (double)timeUs, (unsigned long)worstUs, BUDGET_US);
+}
+
+int main() {
+    Grid3x3Engine engine;
+    BitBoard board;
+    walk3x3(engine, board, 1);
+    printf("3x3 contra a tabela resolvida: %lu posições, %lu divergências\n",
+           (unsigned long)checked, (unsigned long)mismatches);
+
+    selfPlay<4, 3>();
+    selfPlay<5, 4>();
+    return mismatches != 0;
+}
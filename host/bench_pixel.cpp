@@ -0,0 +1,115 @@
+// Compara a codificação de cores antiga (convertData com switch sobre os
+// bytes do formato, escolhido em tempo de execução) com o PixelFormat
+// resolvido em tempo de compilação.
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include "WS2812.hpp"
+
+#define PIXEL_COUNT 25
+#define COLOR_COUNT 4096
+#define ROUNDS 20000
+
+// Cores constantes viram palavras prontas já na compilação
+static_assert(WS2812::color(30, 0, 0).word == 0x001E0000, "GRB: vermelho no segundo byte");
+static_assert(WS2812::color(0, 30, 0).word == 0x1E000000, "GRB: verde no primeiro byte");
+static_assert(FormatWRGB::encode(WS2812::RGBW(1, 2, 3, 4)) == 0x04010203, "WRGB em 32 bits");
+
+// Implementação original, fora de linha como era em WS2812.cpp
+struct LegacyEncoder {
+    WS2812Base::DataByte bytes[4];
+
+    __attribute__((noinline)) uint32_t convertData(uint32_t rgbw) const {
+        uint32_t result = 0;
+        for (uint b = 0; b < 4; b++) {
+            switch (bytes[b]) {
+                case WS2812Base::RED:
+                    result |= (rgbw & 0xFF);
+                    break;
+                case WS2812Base::GREEN:
+                    result |= (rgbw & 0xFF00) >> 8;
+                    break;
+                case WS2812Base::BLUE:
+                    result |= (rgbw & 0xFF0000) >> 16;
+                    break;
+                case WS2812Base::WHITE:
+                    result |= (rgbw & 0xFF000000) >> 24;
+                    break;
+                default:
+                    break;
+            }
+            result <<= 8;
+        }
+        return result;
+    }
+};
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static uint32_t colors[COLOR_COUNT];
+static uint32_t pixels[PIXEL_COUNT];
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Format>
+static bool matchesLegacy(const LegacyEncoder &legacy, const char *name) {
+    for (int i = 0; i < COLOR_COUNT; i++) {
+        if (legacy.convertData(colors[i]) != Format::encode(colors[i])) {
+            printf("Divergência %s na cor %08X\n", name, colors[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    for (int i = 0; i < COLOR_COUNT; i++) {
+        colors[i] = nextRandom() & 0x00FFFFFF;
+    }
+
+    // Formatos de 24 bits devem dar exatamente as mesmas palavras
+    LegacyEncoder grb = {{WS2812Base::NONE, WS2812Base::GREEN, WS2812Base::RED, WS2812Base::BLUE}};
+    LegacyEncoder rgb = {{WS2812Base::NONE, WS2812Base::RED, WS2812Base::GREEN, WS2812Base::BLUE}};
+    if (!matchesLegacy<FormatGRB>(grb, "GRB") || !matchesLegacy<FormatRGB>(rgb, "RGB")) return 1;
+
+    // Em WRGB o código antigo deslocava o branco para fora da palavra
+    LegacyEncoder wrgb = {{WS2812Base::WHITE, WS2812Base::RED, WS2812Base::GREEN, WS2812Base::BLUE}};
+    printf("WRGB(1,2,3,4): antigo %08X, novo %08X\n",
+           wrgb.convertData(WS2812::RGBW(1, 2, 3, 4)), FormatWRGB::encode(WS2812::RGBW(1, 2, 3, 4)));
+
+    const double encodes = (double)COLOR_COUNT * ROUNDS;
+    volatile uint32_t sink = 0;
+
+    // Mesmo padrão de setPixelColor: codifica e grava no buffer da fita
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COLOR_COUNT; i++) {
+            pixels[i % PIXEL_COUNT] = grb.convertData(colors[i]);
+        }
+        sink = sink + pixels[r % PIXEL_COUNT];
+    }
+    double legacySeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COLOR_COUNT; i++) {
+            pixels[i % PIXEL_COUNT] = FormatGRB::encode(colors[i]);
+        }
+        sink = sink + pixels[r % PIXEL_COUNT];
+    }
+    double formatSeconds = secondsSince(start);
+
+    printf("convertData: %.2f ns/pixel\n", legacySeconds / encodes * 1e9);
+    printf("PixelFormat: %.2f ns/pixel\n", formatSeconds / encodes * 1e9);
+    printf("ganho:       %.2fx\n", legacySeconds / formatSeconds);
+    return sink == 0xFFFFFFFF;
+}
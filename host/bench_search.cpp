@@ -0,0 +1,106 @@
+// Percorre todas as posições alcançáveis com a IA na vez, confere as jogadas
+// de TicTacToeAI contra um minimax sem poda e mede nós e tempo por busca.
+#include <stdio.h>
+#include <stdint.h>
+#include "BitBoard.hpp"
+#include "TicTacToeAI.hpp"
+
+typedef struct {
+    uint32_t positions;
+    uint32_t mismatches;
+    uint32_t maxNodes;
+    uint32_t maxTimeUs;
+    uint64_t totalNodes;
+    uint64_t totalTimeUs;
+} Report;
+
+// Valor de referência: vitória vale mais quanto menos peças houver no tabuleiro
+static int minimax(BitBoard& board, uint8_t player) {
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    uint8_t pieces = board.moveCount();
+    if (board.checkWin(opponent)) return -(TicTacToeAI::WIN_SCORE + BitBoard::CELL_COUNT - pieces);
+    if (pieces == BitBoard::CELL_COUNT) return 0;
+
+    int best = -100;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        int score = -minimax(board, opponent);
+        board.unmakeMove(cell, player);
+        if (score > best) best = score;
+    }
+    return best;
+}
+
+static void checkPosition(TicTacToeAI& ai, BitBoard& board, Report& report) {
+    SearchResult result;
+    // Tabela limpa: mede o pior caso de cada busca isolada
+    ai.clearTable();
+    if (!ai.search(board, 1, result)) return;
+
+    uint16_t expected = 0;
+    int best = -100;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, 1);
+        int score = -minimax(board, 2);
+        board.unmakeMove(cell, 1);
+        if (score > best) {
+            best = score;
+            expected = 1u << cell;
+        } else if (score == best) {
+            expected |= 1u << cell;
+        }
+    }
+
+    report.positions++;
+    if (result.bestMoves != expected || result.score != best) report.mismatches++;
+    if (result.nodes > report.maxNodes) report.maxNodes = result.nodes;
+    if (result.timeUs > report.maxTimeUs) report.maxTimeUs = result.timeUs;
+    report.totalNodes += result.nodes;
+    report.totalTimeUs += result.timeUs;
+}
+
+// Gera todas as posições alcançáveis (IA começa) e testa as que são da IA
+static void walk(TicTacToeAI& ai, BitBoard& board, uint8_t player, uint16_t* visited, Report& report) {
+    uint32_t key = ((uint32_t)board.playerMask(1) << 9) | board.playerMask(2);
+    if (visited[key >> 4] & (1u << (key & 15))) return;
+    visited[key >> 4] |= 1u << (key & 15);
+
+    if (board.checkWin(1) || board.checkWin(2) || board.isFull()) return;
+    if (player == 1) checkPosition(ai, board, report);
+
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        walk(ai, board, opponent, visited, report);
+        board.unmakeMove(cell, player);
+    }
+}
+
+static uint16_t visited[(1 << 18) / 16];
+
+int main() {
+    static TicTacToeAI ai;
+    BitBoard board;
+    Report report = {};
+
+    walk(ai, board, 1, visited, report);
+
+    SearchResult empty;
+    ai.clearTable();
+    ai.search(BitBoard(), 1, empty);
+
+    printf("posições: %lu, divergências: %lu\n",
+           (unsigned long)report.positions, (unsigned long)report.mismatches);
+    printf("tabuleiro vazio: %lu nós, %lu us\n",
+           (unsigned long)empty.nodes, (unsigned long)empty.timeUs);
+    printf("pior caso: %lu nós, %lu us\n",
+           (unsigned long)report.maxNodes, (unsigned long)report.maxTimeUs);
+    printf("média: %.1f nós, %.2f us\n",
+           (double)report.totalNodes / report.positions,
+           (double)report.totalTimeUs / report.positions);
+    printf("RAM da tabela de transposição: %u bytes\n", (unsigned)sizeof(ai));
+    return report.mismatches != 0;
+}
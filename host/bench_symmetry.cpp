@@ -0,0 +1,155 @@
+// Confere as 8 simetrias do BoardSymmetry (bijeção, inversas, ida e volta
+// das jogadas) em todos os tabuleiros, conta as classes canônicas das
+// posições alcançáveis e mede canonicalizações por segundo contra a versão
+// casa a casa.
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include "BitBoard.hpp"
+#include "BoardSymmetry.hpp"
+#include "SolvedTable.hpp"
+
+#define BENCH_ROUNDS 2000
+#define KEY_SPACE (1u << 18)
+#define ENTRY_BYTES 2           // valor + jogadas, como na tabela resolvida
+#define SPARSE_KEY_BYTES 4      // chave guardada ao lado da entrada
+
+static uint32_t failures = 0;
+
+static void fail(const char* what, uint32_t key) {
+    if (failures < 10) printf("falha: %s (chave 0x%05lx)\n", what, (unsigned long)key);
+    failures++;
+}
+
+// Referência: aplica a simetria casa a casa pela tabela de casas
+static uint32_t applyNaive(uint8_t symmetry, uint32_t packed) {
+    uint32_t out = 0;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        uint8_t image = BoardSymmetry::toCanonical(symmetry, cell);
+        if (packed & (1u << cell)) out |= 1u << image;
+        if (packed & (1u << (cell + 16))) out |= 1u << (image + 16);
+    }
+    return out;
+}
+
+// Mesmo critério do BoardSymmetry: menor palavra empacotada
+static CanonicalPosition canonicalNaive(uint32_t packed) {
+    uint32_t best = packed;
+    uint8_t symmetry = 0;
+    for (uint8_t s = 1; s < BoardSymmetry::COUNT; s++) {
+        uint32_t image = applyNaive(s, packed);
+        if (image < best) {
+            best = image;
+            symmetry = s;
+        }
+    }
+    return {BoardSymmetry::key(best), symmetry};
+}
+
+// Todos os tabuleiros sem sobreposição (3^9), alcançáveis ou não
+static uint32_t allBoards[19683];
+static uint32_t allCount = 0;
+
+static void checkBoard(uint32_t packed) {
+    uint32_t key = BoardSymmetry::key(packed);
+    CanonicalPosition canon = BoardSymmetry::canonical(packed);
+
+    for (uint8_t s = 0; s < BoardSymmetry::COUNT; s++) {
+        uint32_t image = BoardSymmetry::apply(s, packed);
+        if (image != applyNaive(s, packed)) fail("permutação difere da tabela de casas", key);
+        if (BoardSymmetry::apply(BoardSymmetry::inverse(s), image) != packed) fail("inversa", key);
+        if (BoardSymmetry::canonical(image).key != canon.key) fail("imagem com outra forma canônica", key);
+    }
+    if (BoardSymmetry::key(BoardSymmetry::apply(canon.symmetry, packed)) != canon.key)
+        fail("simetria não leva à forma canônica", key);
+    if (canonicalNaive(packed).key != canon.key) fail("forma canônica difere da referência", key);
+
+    // Jogada levada à forma canônica e de volta cai na mesma casa
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        uint8_t mapped = BoardSymmetry::toCanonical(canon.symmetry, cell);
+        if (BoardSymmetry::fromCanonical(canon.symmetry, mapped) != cell) fail("ida e volta da jogada", key);
+        uint32_t moved = BoardSymmetry::apply(canon.symmetry, packed | (1u << cell));
+        if (!(moved & (1u << mapped))) fail("jogada fora da imagem", key);
+    }
+}
+
+static bool visited[KEY_SPACE];
+static bool canonicalSeen[KEY_SPACE];
+static uint32_t reachable = 0, reachableOpen = 0;
+static uint32_t classes = 0, classesOpen = 0;
+
+// Posições alcançáveis com a IA começando
+static void walk(BitBoard& board, uint8_t player) {
+    uint32_t packed = BoardSymmetry::pack(board);
+    uint32_t key = BoardSymmetry::key(packed);
+    if (visited[key]) return;
+    visited[key] = true;
+
+    bool terminal = board.checkWin(1) || board.checkWin(2) || board.isFull();
+    reachable++;
+    if (!terminal) reachableOpen++;
+    uint32_t canon = BoardSymmetry::canonical(packed).key;
+    if (!canonicalSeen[canon]) {
+        canonicalSeen[canon] = true;
+        classes++;
+        if (!terminal) classesOpen++;
+    }
+    if (terminal) return;
+
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        walk(board, opponent);
+        board.unmakeMove(cell, player);
+    }
+}
+
+template <typename F>
+static double timeNs(F canonicalize) {
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        uint32_t acc = 0;
+        for (uint32_t i = 0; i < allCount; i++) acc += canonicalize(allBoards[i]);
+        sink = sink + acc;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / ((double)BENCH_ROUNDS * allCount);
+}
+
+int main() {
+    for (uint32_t index = 0; index < 19683; index++) {
+        uint16_t ai = 0, human = 0;
+        uint32_t rest = index;
+        for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++, rest /= 3) {
+            if (rest % 3 == 1) ai |= 1u << cell;
+            else if (rest % 3 == 2) human |= 1u << cell;
+        }
+        allBoards[allCount++] = BoardSymmetry::pack(ai, human);
+    }
+    for (uint32_t i = 0; i < allCount; i++) checkBoard(allBoards[i]);
+
+    BitBoard board;
+    walk(board, 1);
+
+    double fast = timeNs([](uint32_t w) { return BoardSymmetry::canonical(w).key; });
+    double naive = timeNs([](uint32_t w) { return canonicalNaive(w).key; });
+
+    printf("tabuleiros conferidos: %lu, falhas: %lu\n", (unsigned long)allCount, (unsigned long)failures);
+    printf("alcançáveis: %lu posições -> %lu classes (não terminais: %lu -> %lu)\n",
+           (unsigned long)reachable, (unsigned long)classes,
+           (unsigned long)reachableOpen, (unsigned long)classesOpen);
+    printf("canonicalização: %.2f ns (%.1f M/s), casa a casa %.2f ns (%.1f M/s)\n",
+           fast, 1e3 / fast, naive, 1e3 / naive);
+    printf("memória (entradas de %u bytes):\n", ENTRY_BYTES);
+    printf("  densa base 3:       %6u bytes\n", (unsigned)sizeof(SOLVED_TABLE));
+    printf("  esparsa por chave:  %6lu bytes (%lu entradas)\n",
+           (unsigned long)reachableOpen * (SPARSE_KEY_BYTES + ENTRY_BYTES), (unsigned long)reachableOpen);
+    printf("  esparsa canônica:   %6lu bytes (%lu entradas, %.1fx menos)\n",
+           (unsigned long)classesOpen * (SPARSE_KEY_BYTES + ENTRY_BYTES), (unsigned long)classesOpen,
+           (double)reachableOpen / classesOpen);
+
+    if (classes != 765 || reachable != 5478) fail("contagem de classes", 0);
+    return failures != 0;
+}
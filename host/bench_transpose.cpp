@@ -0,0 +1,158 @@
+// Saída paralela do WS2812: confere a transposição por bit-slicing
+// (WS2812Base::transposeLanes) contra a versão bit a bit, o caminho
+// inteiro de show() com várias fitas e o tempo de quadro, e mede o custo da
+// transposição por LED e por quadro.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "Hal.hpp"
+#include "WS2812.hpp"
+
+#define LANE_LENGTH 256
+#define ROUNDS 2000
+#define FIRST_PIN 2
+
+static uint32_t failures = 0;
+
+static void fail(const char *what, uint32_t value) {
+    if (failures < 10) printf("falha: %s (%lu)\n", what, (unsigned long)value);
+    failures++;
+}
+
+static uint32_t rngState = 0x12345678;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Referência: um bit de uma fita por vez, direto da definição
+__attribute__((noinline))
+static void transposeReference(const uint32_t *pixels, uint lanes, uint laneLength, uint bits, uint32_t *planes) {
+    memset(planes, 0, laneLength * bits / 4 * sizeof(uint32_t));
+    for (uint i = 0; i < laneLength; i++) {
+        uint32_t *out = planes + i * bits / 4;
+        for (uint t = 0; t < bits; t++) {
+            for (uint lane = 0; lane < lanes; lane++) {
+                uint32_t bit = (pixels[lane * laneLength + i] >> (31 - t)) & 1;
+                out[t / 4] |= bit << (24 - 8 * (t % 4) + lane);
+            }
+        }
+    }
+}
+
+static void randomPixels(std::vector<uint32_t> &pixels, uint bits) {
+    for (uint32_t &word : pixels) word = (bits == 24) ? nextRandom() & 0xFFFFFF00 : nextRandom();
+}
+
+static void checkKernel() {
+    const uint lengths[] = {1, 7, 25, LANE_LENGTH};
+    const uint bitCounts[] = {24, 32};
+    for (uint lanes = 1; lanes <= WS2812_MAX_LANES; lanes++) {
+        for (uint l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            for (uint b = 0; b < 2; b++) {
+                uint bits = bitCounts[b];
+                std::vector<uint32_t> pixels(lanes * lengths[l]);
+                std::vector<uint32_t> expected(lengths[l] * bits / 4), planes(expected.size());
+                randomPixels(pixels, bits);
+                transposeReference(pixels.data(), lanes, lengths[l], bits, expected.data());
+                WS2812Base::transposeLanes(pixels.data(), lanes, lengths[l], bits, planes.data());
+                if (planes != expected) fail("transposição", lanes * 1000 + lengths[l]);
+            }
+        }
+    }
+}
+
+// Acesso aos planos que vão para a FIFO
+class PlaneProbe : public WS2812Parallel {
+public:
+    PlaneProbe(uint pin, uint lanes, uint laneLength) : WS2812Parallel(pin, lanes, laneLength) {}
+    const uint32_t *planes() const { return planeData; }
+};
+
+// show() com várias fitas: planos iguais aos da referência sobre as cores
+// codificadas, e o quadro ocupa o tempo de uma fita só
+static void checkStrip() {
+    uint64_t wireUs[2] = {0, 0};
+    const uint laneCounts[2] = {1, WS2812_MAX_LANES};
+    for (uint c = 0; c < 2; c++) {
+        uint lanes = laneCounts[c];
+        PlaneProbe strip(FIRST_PIN, lanes, LANE_LENGTH);
+        if (!strip.hasOutput() || strip.laneCount() != lanes) fail("fita paralela sem saída", lanes);
+        strip.setGammaEnabled(false);
+
+        std::vector<uint32_t> encoded(lanes * LANE_LENGTH);
+        for (uint lane = 0; lane < lanes; lane++) {
+            for (uint i = 0; i < LANE_LENGTH; i++) {
+                WS2812::Color color = WS2812::color(nextRandom() & 0x3F, nextRandom() & 0x3F, nextRandom() & 0x3F);
+                strip.setPixelColor(strip.pixel(lane, i), color);
+                encoded[lane * LANE_LENGTH + i] = color.word;
+            }
+        }
+        uint64_t start = halTimeUs();
+        strip.show();
+        strip.waitForFrame();
+        wireUs[c] = halTimeUs() - start;
+
+        std::vector<uint32_t> expected(LANE_LENGTH * 24 / 4);
+        transposeReference(encoded.data(), lanes, LANE_LENGTH, 24, expected.data());
+        if (lanes > 1 && memcmp(strip.planes(), expected.data(), expected.size() * sizeof(uint32_t)) != 0)
+            fail("planos do show()", lanes);
+        if (lanes > 1 && WS2812Base::pioBlockStats(0, WS2812Base::PROGRAM_PARALLEL).strips != 1)
+            fail("registro do programa paralelo", lanes);
+        strip.resetStats();
+    }
+    printf("quadro de %u LEDs: %llu us com 1 fita, %llu us com %u fitas\n", LANE_LENGTH,
+           (unsigned long long)wireUs[0], (unsigned long long)wireUs[1], WS2812_MAX_LANES);
+    if (wireUs[1] > wireUs[0] + wireUs[0] / 20) fail("tempo de quadro cresce com as fitas", (uint32_t)wireUs[1]);
+    if (WS2812Base::pioBlockStats(0, WS2812Base::PROGRAM_PARALLEL).programOffset >= 0)
+        fail("programa paralelo não removido", 0);
+}
+
+static void benchmark() {
+    const uint lanes = WS2812_MAX_LANES, bits = 24;
+    std::vector<uint32_t> pixels(lanes * LANE_LENGTH), planes(LANE_LENGTH * bits / 4);
+    randomPixels(pixels, bits);
+    volatile uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS / 10; r++) {
+        transposeReference(pixels.data(), lanes, LANE_LENGTH, bits, planes.data());
+        sink = sink + planes[r % planes.size()];
+    }
+    double referenceSeconds = secondsSince(start) * 10;
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        WS2812Base::transposeLanes(pixels.data(), lanes, LANE_LENGTH, bits, planes.data());
+        sink = sink + planes[r % planes.size()];
+    }
+    double sliceSeconds = secondsSince(start);
+
+    double leds = (double)lanes * LANE_LENGTH * ROUNDS;
+    printf("%u fitas x %u LEDs, %u bits:\n", lanes, LANE_LENGTH, bits);
+    printf("bit a bit:    %.2f ns/LED, %.1f us/quadro\n", referenceSeconds / leds * 1e9, referenceSeconds / ROUNDS * 1e6);
+    printf("bit-slicing:  %.2f ns/LED, %.1f us/quadro\n", sliceSeconds / leds * 1e9, sliceSeconds / ROUNDS * 1e6);
+    printf("ganho:        %.1fx (quadro no fio: %u us)\n", referenceSeconds / sliceSeconds, LANE_LENGTH * bits * 5 / 4);
+    if (sink == 0xFFFFFFFF) printf("\n");
+}
+
+int main() {
+    setenv("TICTACTOE_RENDER", "none", 1);
+    halInit();
+
+    checkKernel();
+    checkStrip();
+    benchmark();
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
@@ -0,0 +1,65 @@
+// MCTS do Ultimate Tic-Tac-Toe: mede simulações por segundo e memória da
+// árvore, e joga contra um jogador aleatório para conferir a força.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "UltimateEngine.hpp"
+
+#define NODE_POOL 65536
+#define GAMES 20
+
+static uint32_t rngState = 0xC0FFEE;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+int main(int argc, char** argv) {
+    uint32_t playouts = (argc > 1) ? (uint32_t)atoi(argv[1]) : 2000;
+    UltimateMcts mcts(NODE_POOL);
+    MctsLimits limits = {playouts, 0};
+
+    // Desempenho a partir da abertura
+    UltimateState opening;
+    MctsResult result;
+    MctsLimits benchLimits = {0, 1000000};
+    mcts.search(opening, benchLimits, result);
+    printf("abertura, 1 s: %lu simulações (%lu/s), %lu nós, %lu bytes de árvore (pool de %lu bytes)\n",
+           (unsigned long)result.playouts, (unsigned long)result.playoutsPerSecond,
+           (unsigned long)result.nodesUsed, (unsigned long)result.treeBytes,
+           (unsigned long)(NODE_POOL * UltimateMcts::nodeBytes()));
+
+    // MCTS (jogador 1 ou 2, alternando) contra aleatório
+    uint32_t wins = 0, draws = 0, losses = 0;
+    uint64_t totalPlayouts = 0, totalUs = 0;
+    uint32_t maxBytes = 0;
+    for (int game = 0; game < GAMES; game++) {
+        UltimateState state;
+        uint8_t mctsPlayer = (game % 2 == 0) ? 1 : 2;
+        while (!state.isOver()) {
+            if (state.toMove() == mctsPlayer) {
+                mcts.search(state, limits, result);
+                state.makeMove(result.move);
+                totalPlayouts += result.playouts;
+                totalUs += result.timeUs;
+                if (result.treeBytes > maxBytes) maxBytes = result.treeBytes;
+            } else {
+                uint8_t moves[UltimateState::MOVE_COUNT];
+                uint8_t count = state.legalMoves(moves);
+                state.makeMove(moves[nextRandom() % count]);
+            }
+        }
+        if (state.winner() == mctsPlayer) wins++;
+        else if (state.winner() == 0) draws++;
+        else losses++;
+    }
+
+    printf("%d jogos com %lu simulações por jogada: %lu vitórias, %lu empates, %lu derrotas\n",
+           GAMES, (unsigned long)playouts, (unsigned long)wins, (unsigned long)draws, (unsigned long)losses);
+    printf("média %.0f simulações/s, maior árvore %lu bytes\n",
+           totalPlayouts * 1e6 / (double)totalUs, (unsigned long)maxBytes);
+    return wins <= losses;
+}
@@ -0,0 +1,408 @@
+// Reproduz gravações do microfone no mesmo ClapDetector do firmware e mede
+// precisão/recall de palmas simples e duplas, latência de decisão e custo
+// de CPU por segundo de áudio.
+//
+// Entradas (várias por execução):
+//   *.clap  roteiro sintético: ruído, zumbido e palmas geradas a partir dele
+//   *.csv   uma contagem do ADC por linha (ou "índice,valor"); "# rate N" e
+//           rótulos em comentários ("# single 1000", "# double 2500 2610")
+//   *.wav   PCM 16 bits; rótulos em <arquivo>.labels
+//
+// Opções (mudam a configuração padrão do firmware):
+//   --threshold V  --window MS  --gap MS  --interval MS
+//   --min F        piso de precisão e recall (padrão 0.9): abaixo disso sai com 1
+//   --csv DIR      grava cada traço sintético como CSV em DIR
+//
+// Ex.: clap_replay host/traces/*.clap
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "ClapDetector.hpp"
+
+#define BLOCK_SAMPLES 80        // uma passada do laço principal (10 ms a 8 kHz)
+#define MATCH_TOLERANCE_MS 60   // distância máxima entre palma rotulada e detectada
+#define CLAP_DECAY_MS 8         // decaimento da palma sintética
+#define CLAP_LENGTH_MS 40
+#define TIMING_ROUNDS 20
+
+typedef struct {
+    ClapGesture gesture;
+    uint32_t firstMs;
+    uint32_t lastMs;            // igual a firstMs nas simples
+} Label;
+
+typedef struct {
+    std::string name;
+    uint32_t rate;
+    std::vector<uint16_t> samples;
+    std::vector<Label> labels;
+} Trace;
+
+typedef struct {
+    ClapEvent event;
+    uint64_t decidedSample;     // amostra em que poll() devolveu o gesto
+} Detection;
+
+typedef struct {
+    uint32_t truePositive[3];
+    uint32_t falsePositive[3];
+    uint32_t falseNegative[3];
+    double latencySumMs;
+    double latencyMaxMs;
+    uint32_t latencyCount;
+    double onsetErrorMaxMs;
+    double audioSeconds;
+    double cpuSeconds;
+} Totals;
+
+static uint32_t rngState = 0x2545F491;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Aproximadamente normal em [-1, 1]: média de quatro uniformes
+static double noiseSample() {
+    double sum = 0;
+    for (int i = 0; i < 4; i++) sum += (nextRandom() & 0xFFFF) / 32767.5 - 1.0;
+    return sum / 4;
+}
+
+static const char *gestureName(ClapGesture gesture) {
+    return gesture == CLAP_SINGLE ? "simples" : gesture == CLAP_DOUBLE ? "dupla" : "-";
+}
+
+static bool endsWith(const std::string &text, const char *suffix) {
+    size_t length = strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+// "single <ms>" ou "double <ms1> <ms2>"; devolve quantos campos numéricos leu
+static int parseLabel(const char *line, Label &label, int extra[2]) {
+    char kind[16];
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    int fields = sscanf(line, " %15s %u %u %u %u", kind, &a, &b, &c, &d);
+    if (fields >= 2 && strcmp(kind, "single") == 0) {
+        label = {CLAP_SINGLE, a, a};
+        extra[0] = (fields >= 3) ? (int)b : -1;
+        return fields - 1;
+    }
+    if (fields >= 3 && strcmp(kind, "double") == 0) {
+        label = {CLAP_DOUBLE, a, b};
+        extra[0] = (fields >= 4) ? (int)c : -1;
+        return fields - 1;
+    }
+    return 0;
+}
+
+static void addClap(Trace &trace, uint32_t ms, int amplitude, std::vector<double> &signal) {
+    uint32_t start = ms * trace.rate / 1000;
+    uint32_t length = CLAP_LENGTH_MS * trace.rate / 1000;
+    double decay = CLAP_DECAY_MS * trace.rate / 1000.0;
+    for (uint32_t i = 0; i < length && start + i < signal.size(); i++) {
+        signal[start + i] += amplitude * exp(-(double)i / decay) * noiseSample();
+    }
+}
+
+// Roteiro sintético:
+//   rate <Hz>  duration <ms>  dc <contagens>  noise <contagens>
+//   hum <contagens> <Hz>      seed <n>
+//   single <ms> [amplitude]   double <ms1> <ms2> [amplitude]
+//   burst <ms> <duração ms> <amplitude>   ruído longo (fala, batida de porta)
+static bool loadSynthetic(const char *path, Trace &trace) {
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+
+    uint32_t durationMs = 5000, dc = 2048, noise = 20, humAmplitude = 0, humHz = 60;
+    struct Burst { uint32_t ms, lengthMs; int amplitude; };
+    std::vector<std::pair<Label, int>> claps;
+    std::vector<Burst> bursts;
+    trace.rate = CLAP_SAMPLE_RATE_HZ;
+
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        char *comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        char key[16];
+        unsigned a = 0, b = 0, c = 0;
+        int fields = sscanf(line, " %15s %u %u %u", key, &a, &b, &c);
+        if (fields < 2) continue;
+
+        Label label;
+        int extra[2];
+        if (parseLabel(line, label, extra)) {
+            claps.push_back({label, extra[0] >= 0 ? extra[0] : 1200});
+            trace.labels.push_back(label);
+        } else if (strcmp(key, "rate") == 0) trace.rate = a;
+        else if (strcmp(key, "duration") == 0) durationMs = a;
+        else if (strcmp(key, "dc") == 0) dc = a;
+        else if (strcmp(key, "noise") == 0) noise = a;
+        else if (strcmp(key, "hum") == 0) { humAmplitude = a; humHz = fields >= 3 ? b : 60; }
+        else if (strcmp(key, "seed") == 0) rngState = a ? a : 1;
+        else if (strcmp(key, "burst") == 0 && fields >= 4) bursts.push_back({a, b, (int)c});
+    }
+    fclose(file);
+
+    std::vector<double> signal((uint64_t)durationMs * trace.rate / 1000);
+    for (size_t i = 0; i < signal.size(); i++) {
+        signal[i] = dc + noise * noiseSample() +
+                    humAmplitude * sin(2 * M_PI * humHz * i / trace.rate);
+    }
+    for (const auto &clap : claps) {
+        addClap(trace, clap.first.firstMs, clap.second, signal);
+        if (clap.first.gesture == CLAP_DOUBLE) addClap(trace, clap.first.lastMs, clap.second, signal);
+    }
+    for (const Burst &burst : bursts) {
+        uint32_t start = burst.ms * trace.rate / 1000;
+        uint32_t length = burst.lengthMs * trace.rate / 1000;
+        for (uint32_t i = 0; i < length && start + i < signal.size(); i++) {
+            signal[start + i] += burst.amplitude * noiseSample();
+        }
+    }
+
+    trace.samples.resize(signal.size());
+    for (size_t i = 0; i < signal.size(); i++) {
+        double value = signal[i] < 0 ? 0 : signal[i] > 4095 ? 4095 : signal[i];
+        trace.samples[i] = (uint16_t)(value + 0.5);
+    }
+    return true;
+}
+
+static bool loadCsv(const char *path, Trace &trace) {
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+    trace.rate = CLAP_SAMPLE_RATE_HZ;
+
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            Label label;
+            int extra[2];
+            unsigned rate;
+            if (sscanf(line + 1, " rate %u", &rate) == 1) trace.rate = rate;
+            else if (parseLabel(line + 1, label, extra)) trace.labels.push_back(label);
+            continue;
+        }
+        const char *field = strrchr(line, ',');
+        field = field ? field + 1 : line;
+        char *end;
+        long value = strtol(field, &end, 10);
+        if (end != field) trace.samples.push_back((uint16_t)(value < 0 ? 0 : value > 4095 ? 4095 : value));
+    }
+    fclose(file);
+    return true;
+}
+
+static uint32_t readLe(const uint8_t *bytes, int count) {
+    uint32_t value = 0;
+    for (int i = count - 1; i >= 0; i--) value = (value << 8) | bytes[i];
+    return value;
+}
+
+// PCM 16 bits (primeiro canal), convertido para contagens de 12 bits
+static bool loadWav(const char *path, Trace &trace) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + read);
+    fclose(file);
+
+    if (bytes.size() < 12 || memcmp(&bytes[0], "RIFF", 4) != 0 || memcmp(&bytes[8], "WAVE", 4) != 0) return false;
+    uint32_t channels = 1, bitsPerSample = 0;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        uint32_t size = readLe(&bytes[offset + 4], 4);
+        const uint8_t *chunk = &bytes[offset + 8];
+        if (memcmp(&bytes[offset], "fmt ", 4) == 0 && size >= 16) {
+            channels = readLe(chunk + 2, 2);
+            trace.rate = readLe(chunk + 4, 4);
+            bitsPerSample = readLe(chunk + 14, 2);
+        } else if (memcmp(&bytes[offset], "data", 4) == 0 && bitsPerSample == 16) {
+            size_t frames = std::min<size_t>(size, bytes.size() - offset - 8) / (2 * channels);
+            for (size_t i = 0; i < frames; i++) {
+                int16_t sample = (int16_t)readLe(chunk + i * 2 * channels, 2);
+                trace.samples.push_back((uint16_t)((sample + 32768) >> 4));
+            }
+        }
+        offset += 8 + size + (size & 1);
+    }
+    if (trace.samples.empty()) return false;
+
+    std::string labels = std::string(path) + ".labels";
+    FILE *labelFile = fopen(labels.c_str(), "r");
+    if (labelFile) {
+        char line[128];
+        while (fgets(line, sizeof(line), labelFile)) {
+            Label label;
+            int extra[2];
+            if (parseLabel(line, label, extra)) trace.labels.push_back(label);
+        }
+        fclose(labelFile);
+    }
+    return true;
+}
+
+static void writeCsv(const Trace &trace, const char *directory) {
+    std::string base = trace.name.substr(trace.name.find_last_of('/') + 1);
+    std::string path = std::string(directory) + "/" + base.substr(0, base.find_last_of('.')) + ".csv";
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) return;
+    fprintf(file, "# rate %u\n", trace.rate);
+    for (const Label &label : trace.labels) {
+        if (label.gesture == CLAP_SINGLE) fprintf(file, "# single %u\n", label.firstMs);
+        else fprintf(file, "# double %u %u\n", label.firstMs, label.lastMs);
+    }
+    for (uint16_t sample : trace.samples) fprintf(file, "%u\n", sample);
+    fclose(file);
+}
+
+// Mesmo fluxo de InputLayer::processClaps: blocos do laço principal e poll()
+static std::vector<Detection> replay(const Trace &trace, const ClapConfig &config) {
+    ClapDetector detector(config);
+    std::vector<Detection> detections;
+    for (size_t offset = 0; offset < trace.samples.size(); offset += BLOCK_SAMPLES) {
+        uint32_t count = (uint32_t)std::min<size_t>(BLOCK_SAMPLES, trace.samples.size() - offset);
+        detector.process(&trace.samples[offset], count);
+        ClapEvent event;
+        if (detector.poll(event)) detections.push_back({event, detector.samplesProcessed()});
+    }
+    return detections;
+}
+
+static void evaluate(const Trace &trace, const std::vector<Detection> &detections, Totals &totals, bool verbose) {
+    std::vector<bool> used(detections.size(), false);
+    double msPerSample = 1000.0 / trace.rate;
+
+    for (const Label &label : trace.labels) {
+        int match = -1;
+        for (size_t i = 0; i < detections.size(); i++) {
+            double firstMs = detections[i].event.firstSample * msPerSample;
+            if (!used[i] && fabs(firstMs - label.firstMs) <= MATCH_TOLERANCE_MS) {
+                match = (int)i;
+                break;
+            }
+        }
+        if (match < 0) {
+            totals.falseNegative[label.gesture]++;
+            if (verbose) printf("  perdida: %s em %u ms\n", gestureName(label.gesture), label.firstMs);
+            continue;
+        }
+        used[match] = true;
+        const Detection &detection = detections[match];
+        if (detection.event.gesture == label.gesture) {
+            totals.truePositive[label.gesture]++;
+        } else {
+            totals.falseNegative[label.gesture]++;
+            totals.falsePositive[detection.event.gesture]++;
+            if (verbose) printf("  trocada: %s em %u ms vista como %s\n", gestureName(label.gesture),
+                                label.firstMs, gestureName(detection.event.gesture));
+        }
+
+        // Latência: da última palma do gesto até a decisão
+        double latency = detection.decidedSample * msPerSample - label.lastMs;
+        totals.latencySumMs += latency;
+        totals.latencyCount++;
+        if (latency > totals.latencyMaxMs) totals.latencyMaxMs = latency;
+        double onsetError = fabs(detection.event.firstSample * msPerSample - label.firstMs);
+        if (onsetError > totals.onsetErrorMaxMs) totals.onsetErrorMaxMs = onsetError;
+    }
+
+    for (size_t i = 0; i < detections.size(); i++) {
+        if (used[i]) continue;
+        totals.falsePositive[detections[i].event.gesture]++;
+        if (verbose) printf("  falsa: %s em %.0f ms\n", gestureName(detections[i].event.gesture),
+                            detections[i].event.firstSample * msPerSample);
+    }
+}
+
+static double ratio(uint32_t numerator, uint32_t denominator) {
+    return denominator ? (double)numerator / denominator : 1.0;
+}
+
+int main(int argc, char **argv) {
+    ClapConfig config = clapDefaultConfig();
+    double minimum = 0.9;
+    const char *csvDirectory = nullptr;
+    std::vector<const char *> paths;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--threshold") == 0 && hasValue)
+            config.thresholdCounts = (uint16_t)(atof(argv[++i]) * (CLAP_ADC_RANGE - 1) / CLAP_ADC_VREF);
+        else if (strcmp(argv[i], "--window") == 0 && hasValue) config.gestureWindowMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--gap") == 0 && hasValue) config.gapTimeoutMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--interval") == 0 && hasValue) config.minIntervalMs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--min") == 0 && hasValue) minimum = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && hasValue) csvDirectory = argv[++i];
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty()) {
+        printf("uso: clap_replay [opções] traço.clap|traço.csv|traço.wav ...\n");
+        return 1;
+    }
+
+    printf("limiar %u contagens, janela %u ms, silêncio %u ms, intervalo %u ms\n",
+           config.thresholdCounts, config.gestureWindowMs, config.gapTimeoutMs, config.minIntervalMs);
+
+    Totals totals = {};
+    for (const char *path : paths) {
+        Trace trace;
+        trace.name = path;
+        std::string name = path;
+        bool loaded = endsWith(name, ".clap") ? loadSynthetic(path, trace)
+                    : endsWith(name, ".wav") ? loadWav(path, trace)
+                    : loadCsv(path, trace);
+        if (!loaded || trace.samples.empty()) {
+            printf("Não foi possível ler %s\n", path);
+            return 1;
+        }
+        if (csvDirectory && endsWith(name, ".clap")) writeCsv(trace, csvDirectory);
+
+        ClapConfig traceConfig = config;
+        traceConfig.sampleRateHz = trace.rate;
+        std::vector<Detection> detections = replay(trace, traceConfig);
+
+        // Custo: o mesmo traço várias vezes, cronometrado
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < TIMING_ROUNDS; r++) replay(trace, traceConfig);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totals.cpuSeconds += seconds / TIMING_ROUNDS;
+        totals.audioSeconds += (double)trace.samples.size() / trace.rate;
+
+        Totals local = {};
+        evaluate(trace, detections, local, false);
+        uint32_t errors = 0;
+        for (int g = CLAP_SINGLE; g <= CLAP_DOUBLE; g++) errors += local.falsePositive[g] + local.falseNegative[g];
+        printf("%s: %zu rótulos, %zu gestos detectados, %u erros\n",
+               path, trace.labels.size(), detections.size(), errors);
+        evaluate(trace, detections, totals, errors > 0);
+    }
+
+    bool pass = true;
+    for (int g = CLAP_SINGLE; g <= CLAP_DOUBLE; g++) {
+        double precision = ratio(totals.truePositive[g], totals.truePositive[g] + totals.falsePositive[g]);
+        double recall = ratio(totals.truePositive[g], totals.truePositive[g] + totals.falseNegative[g]);
+        printf("%-8s precisão %.3f  recall %.3f  (%u certos, %u falsos, %u perdidos)\n",
+               gestureName((ClapGesture)g), precision, recall,
+               totals.truePositive[g], totals.falsePositive[g], totals.falseNegative[g]);
+        if (precision < minimum || recall < minimum) pass = false;
+    }
+    if (totals.latencyCount) {
+        printf("latência da decisão: média %.1f ms, máxima %.1f ms; erro de início máx. %.2f ms\n",
+               totals.latencySumMs / totals.latencyCount, totals.latencyMaxMs, totals.onsetErrorMaxMs);
+    }
+    printf("CPU: %.1f us por segundo de áudio (%.4f%% de um núcleo do host)\n",
+           totals.cpuSeconds / totals.audioSeconds * 1e6, totals.cpuSeconds / totals.audioSeconds * 100);
+    if (!pass) printf("Abaixo do piso de %.2f\n", minimum);
+    return pass ? 0 : 1;
+}
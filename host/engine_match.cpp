@@ -0,0 +1,295 @@
+// Adversário local do protocolo de motor: roda o tictactoe_engine por
+// pipes, como um programa no computador faria com a placa pela USB.
+// Confere o handshake, as respostas de erro (jogada inválida mantém a
+// posição anterior, linha longa, comando desconhecido), joga partidas
+// contra um jogador aleatório nas três variantes alternando quem começa,
+// confere que go respeita o movetime e mede o parser no mesmo processo.
+// Retorna 1 se a 3x3 perder alguma partida ou uma resposta sair errada.
+// Ex.: ./engine_match [caminho do tictactoe_engine]
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "EngineProtocol.hpp"
+
+#define GAMES_3X3 200
+#define GAMES_GRID 20
+#define GRID_MOVETIME_MS 20
+#define LIMIT_MOVETIME_MS 100
+#define LIMIT_MARGIN_MS 50          // folga do pipe e do escalonador
+#define PING_ROUNDS 1000
+#define PARSE_ROUNDS 200000
+#define REPLY_TIMEOUT_MS 5000
+
+static uint32_t failures = 0;
+static int toEngine = -1;
+static int fromEngine = -1;
+static std::string pending;
+
+static void fail(const char *what, long value) {
+    if (failures < 10) printf("falha: %s (%ld)\n", what, value);
+    failures++;
+}
+
+static uint32_t rng = 2463534242u;
+
+static uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void send(const std::string &line) {
+    std::string text = line + "\n";
+    if (write(toEngine, text.data(), text.size()) != (ssize_t)text.size()) fail("escrita no pipe", 0);
+}
+
+static bool readLine(std::string &line) {
+    auto start = std::chrono::steady_clock::now();
+    while (true) {
+        size_t end = pending.find('\n');
+        if (end != std::string::npos) {
+            line = pending.substr(0, end);
+            pending.erase(0, end + 1);
+            return true;
+        }
+        int left = REPLY_TIMEOUT_MS - (int)msSince(start);
+        struct pollfd fd = {fromEngine, POLLIN, 0};
+        if (left <= 0 || poll(&fd, 1, left) <= 0) return false;
+        char buffer[1024];
+        ssize_t n = read(fromEngine, buffer, sizeof(buffer));
+        if (n <= 0) return false;
+        pending.append(buffer, n);
+    }
+}
+
+// Lê até a linha que começa com 'prefix'; a última linha info fica em 'info'
+static bool expect(const char *prefix, std::string &line, std::string *info = nullptr) {
+    while (readLine(line)) {
+        if (info && line.compare(0, 5, "info ") == 0) *info = line;
+        if (line.compare(0, strlen(prefix), prefix) == 0) return true;
+    }
+    return false;
+}
+
+static pid_t startEngine(const char *path) {
+    int in[2], out[2];
+    if (pipe(in) != 0 || pipe(out) != 0) return -1;
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(in[0], STDIN_FILENO);
+        dup2(out[1], STDOUT_FILENO);
+        close(in[1]);
+        close(out[0]);
+        execl(path, path, (char *)nullptr);
+        _exit(127);
+    }
+    close(in[0]);
+    close(out[1]);
+    toEngine = in[1];
+    fromEngine = out[0];
+    return pid;
+}
+
+// Vencedor numa grade N x N com K em linha: 0, 1 ou 2
+static uint8_t winnerOf(const std::vector<uint8_t> &cells, int n, int k) {
+    const int dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {-1, 1}};
+    for (int y = 0; y < n; y++)
+        for (int x = 0; x < n; x++) {
+            uint8_t player = cells[y * n + x];
+            if (!player) continue;
+            for (const auto &d : dirs) {
+                int i = 1;
+                while (i < k) {
+                    int cx = x + d[0] * i, cy = y + d[1] * i;
+                    if (cx < 0 || cy < 0 || cx >= n || cy >= n || cells[cy * n + cx] != player) break;
+                    i++;
+                }
+                if (i == k) return player;
+            }
+        }
+    return 0;
+}
+
+typedef struct {
+    uint32_t wins, draws, losses;
+    uint64_t nodes, timeUs;
+    uint32_t searches;
+    double maxReplyMs;
+} MatchStats;
+
+// Uma partida; o motor joga como 'enginePlayer' (1 começa)
+static void playGame(int n, int k, uint8_t enginePlayer, uint32_t movetimeMs, MatchStats &stats) {
+    std::vector<uint8_t> cells(n * n, 0);
+    std::string moves = "position startpos moves";
+    send("ucinewgame");
+    for (int ply = 0; ply < n * n; ply++) {
+        uint8_t player = (ply % 2) ? 2 : 1;
+        int cell;
+        if (player == enginePlayer) {
+            send(moves);
+            auto start = std::chrono::steady_clock::now();
+            send("go movetime " + std::to_string(movetimeMs));
+            std::string line, info;
+            if (!expect("bestmove", line, &info)) {
+                fail("sem bestmove", ply);
+                return;
+            }
+            double replyMs = msSince(start);
+            if (replyMs > stats.maxReplyMs) stats.maxReplyMs = replyMs;
+            unsigned long nodes = 0, timeUs = 0;
+            const char *at = strstr(info.c_str(), "nodes ");
+            if (at) nodes = strtoul(at + 6, nullptr, 10);
+            at = strstr(info.c_str(), "timeus ");
+            if (at) timeUs = strtoul(at + 7, nullptr, 10);
+            stats.nodes += nodes;
+            stats.timeUs += timeUs;
+            stats.searches++;
+            cell = atoi(line.c_str() + 9);
+            if (cell < 0 || cell >= n * n || cells[cell] != 0) {
+                fail("bestmove ilegal", cell);
+                return;
+            }
+        } else {
+            do cell = nextRandom() % (n * n);
+            while (cells[cell] != 0);
+        }
+        cells[cell] = player;
+        moves += " " + std::to_string(cell);
+        uint8_t winner = winnerOf(cells, n, k);
+        if (winner) {
+            if (winner == enginePlayer) stats.wins++;
+            else stats.losses++;
+            return;
+        }
+    }
+    stats.draws++;
+}
+
+static void match(const char *name, const char *variant, const char *engine, int n, int k, uint32_t games,
+                  uint32_t movetimeMs, bool mustNotLose) {
+    send(std::string("setoption name Variant value ") + variant);
+    if (engine) send(std::string("setoption name Engine value ") + engine);
+    MatchStats stats = {};
+    for (uint32_t g = 0; g < games; g++) playGame(n, k, (g % 2) ? 2 : 1, movetimeMs, stats);
+    printf("%-17s %4u partidas: %3u vitórias, %3u empates, %3u derrotas  %8.0f nós/busca  %8.1f us/busca  "
+           "resposta máx %.1f ms\n",
+           name, games, stats.wins, stats.draws, stats.losses,
+           stats.searches ? (double)stats.nodes / stats.searches : 0.0,
+           stats.searches ? (double)stats.timeUs / stats.searches : 0.0, stats.maxReplyMs);
+    if (mustNotLose && stats.losses) fail(name, stats.losses);
+}
+
+// Parser no mesmo processo: só linhas que não imprimem nada
+static void measureParser() {
+    EngineProtocol engine;
+    const char *lines[] = {
+        "position startpos moves 0 4 8 2 6 3 5 7 1",
+        "position startpos",
+        "position   startpos   moves 4 0\t8",
+    };
+    char buffer[ENGINE_LINE_MAX + 1];
+    std::vector<double> samples;
+    samples.reserve(PARSE_ROUNDS);
+    for (uint32_t r = 0; r < PARSE_ROUNDS; r++) {
+        const char *text = lines[r % 3];
+        auto start = std::chrono::steady_clock::now();
+        for (const char *c = text; *c; c++) engine.feed(*c);
+        engine.feed('\n');
+        samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    strcpy(buffer, lines[0]);
+    engine.handleLine(buffer);
+    if (engine.cell(8) != 1 || engine.cell(1) != 1 || engine.cell(7) != 2) fail("posição pelo parser", 0);
+    // O máximo inclui as preempções do sistema; o p99,9 é o custo da linha
+    double totalNs = 0;
+    for (double ns : samples) totalNs += ns;
+    std::sort(samples.begin(), samples.end());
+    printf("parser: %.0f ns/linha em média, p99,9 %.0f ns (%u linhas, até %u caracteres)\n",
+           totalNs / samples.size(), samples[samples.size() * 999 / 1000], PARSE_ROUNDS, ENGINE_LINE_MAX);
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : TICTACTOE_ENGINE_PATH;
+    signal(SIGPIPE, SIG_IGN);
+    measureParser();
+
+    pid_t pid = startEngine(path);
+    if (pid < 0) {
+        printf("falha: não foi possível iniciar %s\n", path);
+        return 1;
+    }
+
+    std::string line;
+    send("uci");
+    if (!expect("uciok", line)) {
+        printf("falha: sem uciok\n");
+        kill(pid, SIGKILL);
+        return 1;
+    }
+
+    // Ida e volta de um comando sem busca
+    auto start = std::chrono::steady_clock::now();
+    double worst = 0;
+    for (uint32_t i = 0; i < PING_ROUNDS; i++) {
+        auto ping = std::chrono::steady_clock::now();
+        send("isready");
+        if (!expect("readyok", line)) fail("sem readyok", i);
+        worst = std::max(worst, msSince(ping));
+    }
+    printf("isready: %.1f us de ida e volta em média, pior %.1f us\n", msSince(start) * 1000 / PING_ROUNDS,
+           worst * 1000);
+
+    // Erros: a posição anterior continua valendo
+    send("position startpos moves 0");
+    send("position startpos moves 1 1");
+    if (!expect("info string erro", line)) fail("jogada repetida aceita", 0);
+    send("go");
+    if (!expect("bestmove", line) || atoi(line.c_str() + 9) == 0) fail("posição perdida depois do erro", 0);
+    send("position startpos moves 9");
+    if (!expect("info string erro", line)) fail("casa fora do tabuleiro aceita", 9);
+    send("xyzzy");
+    if (!expect("info string erro", line)) fail("comando desconhecido aceito", 0);
+    send(std::string(ENGINE_LINE_MAX + 20, 'a'));
+    if (!expect("info string erro", line)) fail("linha longa aceita", 0);
+    send("position startpos moves 0 3 1 4 2");
+    send("go");
+    if (!expect("bestmove", line) || line != "bestmove none") fail("partida encerrada sem bestmove none", 0);
+
+    match("3x3 tabela", "3x3", "table", 3, 3, GAMES_3X3, 0, true);
+    match("3x3 negamax", "3x3", "negamax", 3, 3, GAMES_3X3, 0, true);
+    match("4x4 (3 em linha)", "4x4", nullptr, 4, 3, GAMES_GRID, GRID_MOVETIME_MS, false);
+    match("5x5 (4 em linha)", "5x5", nullptr, 5, 4, GAMES_GRID, GRID_MOVETIME_MS, false);
+
+    // movetime: o tabuleiro vazio de 5x5 não se esgota nesse tempo
+    send("setoption name Variant value 5x5");
+    send("position startpos");
+    start = std::chrono::steady_clock::now();
+    send("go movetime " + std::to_string(LIMIT_MOVETIME_MS));
+    std::string info;
+    if (!expect("bestmove", line, &info)) fail("sem bestmove no 5x5", 0);
+    double replyMs = msSince(start);
+    printf("go movetime %u no 5x5 vazio: resposta em %.1f ms (%s)\n", LIMIT_MOVETIME_MS, replyMs, info.c_str());
+    if (replyMs > LIMIT_MOVETIME_MS + LIMIT_MARGIN_MS) fail("movetime estourado (ms)", (long)replyMs);
+
+    send("quit");
+    int result = 0;
+    waitpid(pid, &result, 0);
+    if (!WIFEXITED(result) || WEXITSTATUS(result) != 0) fail("saída do motor", result);
+
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
@@ -0,0 +1,12 @@
+// Protocolo de motor (EngineProtocol.hpp) no stdin/stdout do computador:
+// outro processo joga contra a IA ou mede a IA sem a placa.
+// Ex.: printf 'uci\nposition startpos moves 4\ngo\nquit\n' | ./tictactoe_engine
+#include <stdio.h>
+#include "EngineProtocol.hpp"
+
+int main() {
+    EngineProtocol engine;
+    int c;
+    while (!engine.quitRequested() && (c = getchar()) != EOF) engine.feed((char)c);
+    return 0;
+}
@@ -0,0 +1,17 @@
+// Substituto do Pico SDK no host: blocos PIO são só identificadores
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "pico/types.h"
+
+typedef struct {
+    uint index;
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t hostPio[2];
+#define pio0 (&hostPio[0])
+#define pio1 (&hostPio[1])
+
+#endif // HOST_HARDWARE_PIO_H
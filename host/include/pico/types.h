@@ -0,0 +1,10 @@
+// Substituto do Pico SDK no host: só os tipos usados pelos cabeçalhos do jogo
+#ifndef HOST_PICO_TYPES_H
+#define HOST_PICO_TYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+#endif // HOST_PICO_TYPES_H
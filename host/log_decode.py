@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Decodifica os registros "@L..." do EventLog na saída serial ou do simulador.
+
+Os formatos vêm dos comentários do enum LogEvent em EventLog.hpp; as
+demais linhas passam sem alteração. Lacunas na sequência são avisadas.
+
+Ex.: ./tictactoe_sim | python3 host/log_decode.py
+     python3 host/log_decode.py captura_serial.txt
+"""
+import os
+import re
+import struct
+import sys
+
+HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "EventLog.hpp")
+ENUM_LINE = re.compile(r'^\s*(LOG_\w+)\s*=\s*(\d+),\s*//\s*"(.*)"\s*$')
+CONVERSION = re.compile(r'%[-0-9.]*[duxX]')
+RECORD = re.compile(r'@L([0-9a-f]{32})\s*$')
+
+
+def load_formats(path):
+    formats = {}
+    with open(path, encoding="utf-8") as header:
+        for line in header:
+            match = ENUM_LINE.match(line)
+            if match:
+                formats[int(match.group(2))] = (match.group(1), match.group(3))
+    return formats
+
+
+def decode(stream, formats, out):
+    expected = None
+    announced = 0
+    for line in stream:
+        match = RECORD.search(line)
+        if not match:
+            out.write(line)
+            continue
+        time_us, event, sequence, arg0, arg1 = struct.unpack(">IHHii", bytes.fromhex(match.group(1)))
+        _, fmt = formats.get(event, ("LOG_%d" % event, "%d %d"))
+        if event == 0:
+            # Os descartados já são contados pelo próprio registro
+            announced += arg0
+        else:
+            lost = 0 if expected is None else (sequence - expected) & 0xFFFF
+            if lost > announced:
+                out.write("[log] %d registros perdidos\n" % (lost - announced))
+            announced -= min(lost, announced)
+            expected = (sequence + 1) & 0xFFFF
+        text = fmt % (arg0, arg1)[:len(CONVERSION.findall(fmt))]
+        out.write("[%10.3f ms] %s\n" % (time_us / 1000.0, text))
+
+
+def main():
+    formats = load_formats(os.environ.get("EVENT_LOG_HEADER", HEADER))
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], encoding="utf-8", errors="replace") as stream:
+            decode(stream, formats, sys.stdout)
+    else:
+        decode(sys.stdin, formats, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,269 @@
+// Modo stream de ponta a ponta: roda o simulador num pseudo-terminal em
+// modo raw, como a porta USB CDC do Pico, e faz o papel do computador.
+// Manda quadros no ritmo alvo com erros de propósito (CRC errado, números
+// de sequência pulados, cabeçalho inválido, lixo entre quadros e uma
+// pausa), confere os contadores da linha de estado e o último quadro
+// desenhado, e depois mede quantos quadros/s passam em rajada.
+// Ex.: ./stream_pty [caminho do tictactoe_sim]
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FrameStream.hpp"
+
+#define PACED_FRAMES 180
+#define CORRUPT_FRAME 40            // CRC errado
+#define SKIP_FRAME 80               // pula SKIP_COUNT números de sequência
+#define SKIP_COUNT 3
+#define PAUSE_FRAME 120             // chega PAUSE_PERIODS períodos depois
+#define PAUSE_PERIODS 5
+#define GARBAGE_FRAME 150           // cabeçalho inválido e lixo antes do quadro
+#define BURST_FRAMES 300
+#define START_TIMEOUT_MS 5000
+#define STATUS_TIMEOUT_MS 3000
+
+typedef struct {
+    unsigned long frames, dropped, late, crc, invalid, timeouts, target;
+    unsigned long long bytes;
+    double fps;
+    unsigned leds;
+} Status;
+
+static uint32_t failures = 0;
+static int master = -1;
+static std::string pending;         // saída do simulador ainda sem fim de linha
+static Status status;
+static uint32_t statusLines = 0;
+static std::string matrixRow;       // primeira linha do último quadro desenhado
+static bool captureRow = false;
+
+static void fail(const char *what, unsigned long value) {
+    if (failures < 10) printf("falha: %s (%lu)\n", what, value);
+    failures++;
+}
+
+static void handleLine(const std::string &line) {
+    if (captureRow) {
+        matrixRow = line;
+        captureRow = false;
+    }
+    if (line.find("LEDs no pino") != std::string::npos) captureRow = true;
+    Status s;
+    if (sscanf(line.c_str(),
+               "STREAM quadros=%lu perdidos=%lu atrasados=%lu crc=%lu invalidos=%lu incompletos=%lu bytes=%llu "
+               "fps=%lf alvo=%lu leds=%u",
+               &s.frames, &s.dropped, &s.late, &s.crc, &s.invalid, &s.timeouts, &s.bytes, &s.fps, &s.target,
+               &s.leds) == 10) {
+        status = s;
+        statusLines++;
+    }
+}
+
+// Lê a saída do simulador até 'waitMs' sem nada chegar
+static void pump(int waitMs) {
+    struct pollfd fd = {master, POLLIN, 0};
+    while (poll(&fd, 1, waitMs) > 0) {
+        char buffer[4096];
+        ssize_t n = read(master, buffer, sizeof(buffer));
+        if (n <= 0) return;
+        pending.append(buffer, n);
+        size_t end;
+        while ((end = pending.find('\n')) != std::string::npos) {
+            handleLine(pending.substr(0, end));
+            pending.erase(0, end + 1);
+        }
+        waitMs = 0;
+    }
+}
+
+// O pty tem buffer pequeno: escreve aos poucos, lendo a saída no meio para
+// o simulador não travar num printf
+static void writeAll(const uint8_t *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(master, data, length);
+        if (n > 0) {
+            data += n;
+            length -= n;
+        } else if (n < 0 && errno != EAGAIN) {
+            fail("escrita no pty", errno);
+            return;
+        }
+        pump(0);
+        if (n <= 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+static void sendFrame(uint8_t type, uint16_t sequence, const std::vector<uint8_t> &payload, bool corrupt = false) {
+    std::vector<uint8_t> frame = {STREAM_SYNC0, STREAM_SYNC1, type, (uint8_t)payload.size(),
+                                  (uint8_t)(payload.size() >> 8), (uint8_t)sequence, (uint8_t)(sequence >> 8)};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 2; i < frame.size(); i++) crc = FrameStream::crcUpdate(crc, frame[i]);
+    if (corrupt) frame[frame.size() - 1] ^= 0x40;
+    frame.push_back((uint8_t)crc);
+    frame.push_back((uint8_t)(crc >> 8));
+    writeAll(frame.data(), frame.size());
+}
+
+// Pede a linha de estado e espera até ela mostrar 'frames' quadros
+static bool requestStatus(unsigned long frames) {
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(STATUS_TIMEOUT_MS)) {
+        uint32_t before = statusLines;
+        sendFrame(STREAM_STATUS, 0, {});
+        while (statusLines == before &&
+               std::chrono::steady_clock::now() - start < std::chrono::milliseconds(STATUS_TIMEOUT_MS))
+            pump(10);
+        if (status.frames >= frames) return true;
+    }
+    return false;
+}
+
+static std::vector<uint8_t> gradient(unsigned leds, uint32_t step) {
+    std::vector<uint8_t> payload(leds * 3);
+    for (unsigned i = 0; i < leds; i++) {
+        payload[i * 3] = (uint8_t)(step + i);
+        payload[i * 3 + 1] = (uint8_t)(step * 3);
+        payload[i * 3 + 2] = (uint8_t)(255 - i);
+    }
+    return payload;
+}
+
+static pid_t startSimulator(const char *path) {
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) return -1;
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0) return -1;
+    // Raw como o CDC: sem eco, sem edição de linha e sem traduzir bytes
+    struct termios mode;
+    tcgetattr(slave, &mode);
+    cfmakeraw(&mode);
+    tcsetattr(slave, TCSANOW, &mode);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        setsid();
+        dup2(slave, STDIN_FILENO);
+        dup2(slave, STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDERR_FILENO);
+        close(slave);
+        close(master);
+        setenv("TICTACTOE_STDIN", "1", 1);
+        setenv("TICTACTOE_REALTIME", "1", 1);
+        setenv("TICTACTOE_RENDER", "text", 1);
+        setenv("TICTACTOE_SCRIPT", TICTACTOE_STREAM_SCRIPT, 1);
+        unsetenv("TICTACTOE_FLASH");
+        execl(path, path, (char *)nullptr);
+        _exit(127);
+    }
+    close(slave);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    return pid;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : TICTACTOE_SIM_PATH;
+
+    // Valor de conferência do CRC-16/CCITT-FALSE
+    uint16_t crc = 0xFFFF;
+    for (const char *c = "123456789"; *c; c++) crc = FrameStream::crcUpdate(crc, (uint8_t)*c);
+    if (crc != 0x29B1) fail("CRC de \"123456789\"", crc);
+
+    pid_t pid = startSimulator(path);
+    if (pid < 0) {
+        printf("falha: não foi possível abrir o pty\n");
+        return 1;
+    }
+
+    // A primeira linha de estado sai ao entrar no modo
+    auto start = std::chrono::steady_clock::now();
+    while (statusLines == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::milliseconds(START_TIMEOUT_MS))
+        pump(20);
+    if (statusLines == 0) {
+        printf("falha: o simulador não entrou no modo stream\n");
+        kill(pid, SIGTERM);
+        return 1;
+    }
+    unsigned leds = status.leds;
+    auto period = std::chrono::microseconds(1000000 / status.target);
+    printf("modo stream: %u LEDs, alvo %lu quadros/s\n", leds, status.target);
+
+    // Ritmo alvo, com os erros de propósito
+    uint16_t sequence = 0;
+    unsigned long good = 0, dropped = 0;
+    auto next = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PACED_FRAMES; i++) {
+        if (i == PAUSE_FRAME) next += period * PAUSE_PERIODS;
+        while (std::chrono::steady_clock::now() < next) pump(1);
+        next += period;
+
+        if (i == SKIP_FRAME) {
+            sequence += SKIP_COUNT;
+            dropped += SKIP_COUNT;
+        }
+        if (i == GARBAGE_FRAME) {
+            sendFrame(9, 0, {});
+            const uint8_t garbage[] = {'l', 'i', 'x', 'o', STREAM_SYNC0, 0x00};
+            writeAll(garbage, sizeof(garbage));
+        }
+        bool corrupt = i == CORRUPT_FRAME;
+        sendFrame(STREAM_PIXELS, sequence++, gradient(leds, i), corrupt);
+        if (corrupt) dropped++;
+        else good++;
+    }
+
+    // Último quadro conhecido: LED 0 verde, o resto vermelho
+    std::vector<uint8_t> last(leds * 3, 0);
+    for (unsigned i = 0; i < leds; i++) last[i * 3] = 60;
+    last[0] = 0;
+    last[1] = 60;
+    sendFrame(STREAM_PIXELS, sequence++, last);
+    good++;
+
+    if (!requestStatus(good)) fail("quadros mostrados", status.frames);
+    printf("ritmo: %lu quadros, %lu perdidos, %lu atrasados, %lu CRC, %lu inválidos, %lu incompletos\n",
+           status.frames, status.dropped, status.late, status.crc, status.invalid, status.timeouts);
+    if (status.frames != good) fail("quadros mostrados", status.frames);
+    if (status.dropped != dropped) fail("quadros perdidos", status.dropped);
+    if (status.crc != 1) fail("erros de CRC", status.crc);
+    if (status.invalid != 1) fail("cabeçalhos inválidos", status.invalid);
+    if (status.late < 1) fail("pausa não contada como atraso", status.late);
+    if (matrixRow.compare(0, 4, "G R ") != 0) fail("último quadro desenhado", matrixRow.size());
+
+    // Rajada: tudo que o pty aceitar, sem perder nada
+    unsigned long before = status.frames;
+    auto burstStart = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BURST_FRAMES; i++) sendFrame(STREAM_PIXELS, sequence++, gradient(leds, i));
+    if (!requestStatus(before + BURST_FRAMES)) fail("quadros da rajada", status.frames - before);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - burstStart).count();
+    printf("rajada: %lu quadros em %.3f s = %.0f quadros/s (%.1f KB/s)\n", status.frames - before, seconds,
+           (status.frames - before) / seconds, (status.frames - before) * (leds * 3 + 9) / seconds / 1024);
+    if (status.dropped != dropped || status.crc != 1) fail("perdas na rajada", status.dropped);
+
+    // Fechar o pty é o fim do stdin: o simulador sai sozinho
+    close(master);
+    int result = 0;
+    pid_t done = 0;
+    for (int i = 0; i < 200 && (done = waitpid(pid, &result, WNOHANG)) == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (done != pid || !WIFEXITED(result) || WEXITSTATUS(result) != 0) {
+        kill(pid, SIGKILL);
+        fail("simulador não terminou com o fim do stdin", result);
+    }
+
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
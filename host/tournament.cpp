@@ -0,0 +1,382 @@
+// Torneio de autojogo entre estratégias de IA do jogo clássico 3x3: espalha
+// milhões de partidas por todos os núcleos (pool com roubo de tarefas, RNG
+// por thread) e mede partidas/s, vitórias/empates/derrotas e a distribuição
+// do tempo por jogada. Serve para conferir, antes de gravar as placas, que
+// uma mudança na IA não perdeu força nem velocidade.
+//
+//   ./tournament [-n partidas por confronto] [-j threads] [--seed N]
+//                [--strategies legacy,random,negamax,table]
+//
+// Retorna 1 se uma estratégia ótima (negamax, table) perder alguma partida.
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Hal.hpp"
+#include "BitBoard.hpp"
+#include "TicTacToeAI.hpp"
+#include "SolvedTable.hpp"
+
+#define DEFAULT_GAMES 200000    // partidas por confronto
+#define CHUNK_GAMES 1024        // partidas por tarefa do pool
+#define TIME_BUCKETS 32         // histograma de tempo por jogada, potências de 2 em ns
+
+// RNG por thread (xorshift64*), semeado por tarefa para o resultado não
+// depender de qual thread executou cada tarefa
+class Rng {
+public:
+    void seed(uint64_t value) {
+        // splitmix64 espalha sementes próximas
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        state = (value ^ (value >> 31)) | 1;
+    }
+    uint32_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return (uint32_t)((state * 0x2545F4914F6CDD1Dull) >> 32);
+    }
+    // Bit sorteado de uma máscara não vazia
+    uint8_t pick(uint16_t mask) {
+        uint8_t choice = next() % __builtin_popcount(mask);
+        while (choice--) mask &= mask - 1;
+        return (uint8_t)__builtin_ctz(mask);
+    }
+
+private:
+    uint64_t state = 1;
+};
+
+// Estado de cada thread: RNG e os motores que guardam memória entre jogadas
+typedef struct {
+    Rng rng;
+    TicTacToeAI ai;
+} Worker;
+
+typedef uint8_t (*ChooseMove)(Worker &worker, const BitBoard &board, uint8_t player);
+
+typedef struct {
+    const char *name;
+    ChooseMove choose;
+    bool optimal;               // nunca deveria perder
+    const char *description;
+} Strategy;
+
+static uint16_t emptyMask(const BitBoard &board) {
+    return ~board.occupiedMask() & BitBoard::FULL_MASK;
+}
+
+// makeAIMove original: vence se puder, senão bloqueia, senão sorteia
+static uint8_t chooseLegacy(Worker &worker, const BitBoard &board, uint8_t player) {
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    uint16_t empty = emptyMask(board);
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++)
+        if ((empty & (1u << cell)) && BitBoard::isWinningMask(board.playerMask(player) | (1u << cell))) return cell;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++)
+        if ((empty & (1u << cell)) && BitBoard::isWinningMask(board.playerMask(opponent) | (1u << cell))) return cell;
+    return worker.rng.pick(empty);
+}
+
+static uint8_t chooseRandom(Worker &worker, const BitBoard &board, uint8_t) {
+    return worker.rng.pick(emptyMask(board));
+}
+
+// Negamax com tabela de transposição, sorteio entre as jogadas ótimas
+static uint8_t chooseNegamax(Worker &worker, const BitBoard &board, uint8_t player) {
+    SearchResult result;
+    worker.ai.search(board, player, result);
+    return worker.rng.pick(result.bestMoves);
+}
+
+// Firmware atual: consulta à tabela resolvida, sorteio entre as ótimas
+static uint8_t chooseTable(Worker &worker, const BitBoard &board, uint8_t) {
+    return worker.rng.pick(solvedBestMoves(solvedLookup(board)));
+}
+
+static const Strategy STRATEGIES[] = {
+    {"legacy", chooseLegacy, false, "vence/bloqueia/sorteia (makeAIMove original)"},
+    {"random", chooseRandom, false, "casa vazia sorteada"},
+    {"negamax", chooseNegamax, true, "TicTacToeAI::search"},
+    {"table", chooseTable, true, "SOLVED_TABLE (firmware)"},
+};
+static const uint32_t STRATEGY_COUNT = sizeof(STRATEGIES) / sizeof(STRATEGIES[0]);
+
+// Contagens de um confronto, do ponto de vista de 'a'; [0] com 'a' começando
+typedef struct {
+    uint64_t wins[2];
+    uint64_t draws[2];
+    uint64_t losses[2];
+    uint64_t timeNs;
+} Tally;
+
+typedef struct {
+    uint64_t moves;
+    uint64_t totalNs;
+    uint64_t maxNs;
+    uint64_t buckets[TIME_BUCKETS];
+} MoveTimes;
+
+typedef struct {
+    uint32_t a;
+    uint32_t b;
+    uint32_t match;             // índice do confronto
+    uint64_t firstGame;
+    uint32_t games;
+} Task;
+
+// Fila de uma thread: a dona tira do fim, quem rouba tira do começo
+typedef struct {
+    std::mutex lock;
+    std::deque<Task> tasks;
+} TaskQueue;
+
+typedef struct {
+    std::vector<Tally> tallies;
+    std::vector<MoveTimes> times;
+    uint64_t stolen;
+} WorkerResult;
+
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void recordTime(MoveTimes &times, uint64_t ns) {
+    uint32_t bucket = ns ? 64 - __builtin_clzll(ns) : 0;
+    if (bucket >= TIME_BUCKETS) bucket = TIME_BUCKETS - 1;
+    times.buckets[bucket]++;
+    times.moves++;
+    times.totalNs += ns;
+    if (ns > times.maxNs) times.maxNs = ns;
+}
+
+// Uma partida; retorna o vencedor (0 = empate). O jogador 1 começa, como no firmware
+static uint8_t playGame(Worker &worker, const Strategy *players[3], MoveTimes *times[3]) {
+    BitBoard board;
+    uint8_t player = 1;
+    for (uint8_t ply = 0; ply < BitBoard::CELL_COUNT; ply++) {
+        uint64_t start = nowNs();
+        uint8_t cell = players[player]->choose(worker, board, player);
+        recordTime(*times[player], nowNs() - start);
+        board.makeMove(cell, player);
+        if (board.checkWin(player)) return player;
+        player = (player == 1) ? 2 : 1;
+    }
+    return 0;
+}
+
+static void runTask(Worker &worker, const Task &task, uint64_t seed, WorkerResult &result) {
+    Tally &tally = result.tallies[task.match];
+    uint64_t start = nowNs();
+    for (uint32_t i = 0; i < task.games; i++) {
+        uint64_t game = task.firstGame + i;
+        if (i % CHUNK_GAMES == 0) worker.rng.seed(seed ^ (game * 0x100000001B3ull) ^ task.match);
+        // Alterna quem começa
+        uint32_t side = game & 1;
+        const Strategy *players[3] = {nullptr, &STRATEGIES[side ? task.b : task.a], &STRATEGIES[side ? task.a : task.b]};
+        MoveTimes *times[3] = {nullptr, &result.times[side ? task.b : task.a], &result.times[side ? task.a : task.b]};
+        uint8_t winner = playGame(worker, players, times);
+        uint8_t aPlayer = side ? 2 : 1;
+        if (winner == 0) tally.draws[side]++;
+        else if (winner == aPlayer) tally.wins[side]++;
+        else tally.losses[side]++;
+    }
+    tally.timeNs += nowNs() - start;
+}
+
+static bool popTask(std::vector<TaskQueue> &queues, uint32_t self, Task &task, bool &stolen) {
+    {
+        std::lock_guard<std::mutex> guard(queues[self].lock);
+        if (!queues[self].tasks.empty()) {
+            task = queues[self].tasks.back();
+            queues[self].tasks.pop_back();
+            stolen = false;
+            return true;
+        }
+    }
+    // Fila vazia: rouba da próxima thread que ainda tem trabalho
+    for (uint32_t offset = 1; offset < queues.size(); offset++) {
+        TaskQueue &victim = queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            stolen = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void printTimes(const char *name, const MoveTimes &times) {
+    if (times.moves == 0) return;
+    uint64_t p50 = 0, p99 = 0, seen = 0;
+    for (uint32_t b = 0; b < TIME_BUCKETS; b++) {
+        seen += times.buckets[b];
+        uint64_t upper = b ? (1ull << b) - 1 : 0;
+        if (!p50 && seen * 2 >= times.moves) p50 = upper;
+        if (!p99 && seen * 100 >= times.moves * 99) p99 = upper;
+    }
+    printf("  %-8s %12llu jogadas  média %7.0f ns  p50 <%6llu ns  p99 <%7llu ns  máx %8llu ns\n", name,
+           (unsigned long long)times.moves, (double)times.totalNs / times.moves,
+           (unsigned long long)p50 + 1, (unsigned long long)p99 + 1, (unsigned long long)times.maxNs);
+}
+
+static bool parseStrategies(const char *list, std::vector<uint32_t> &selected) {
+    selected.clear();
+    std::string names(list);
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == std::string::npos) end = names.size();
+        std::string name = names.substr(start, end - start);
+        uint32_t s = 0;
+        while (s < STRATEGY_COUNT && name != STRATEGIES[s].name) s++;
+        if (s == STRATEGY_COUNT) {
+            fprintf(stderr, "estratégia desconhecida: %s\n", name.c_str());
+            return false;
+        }
+        selected.push_back(s);
+        start = end + 1;
+    }
+    return !selected.empty();
+}
+
+int main(int argc, char **argv) {
+    uint64_t gamesPerMatch = DEFAULT_GAMES;
+    uint32_t threadCount = std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    std::vector<uint32_t> selected;
+    for (uint32_t s = 0; s < STRATEGY_COUNT; s++) selected.push_back(s);
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-n") == 0 && hasValue) gamesPerMatch = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "-j") == 0 && hasValue) threadCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue) seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--strategies") == 0 && hasValue) {
+            if (!parseStrategies(argv[++i], selected)) return 2;
+        } else {
+            fprintf(stderr, "uso: %s [-n partidas] [-j threads] [--seed N] [--strategies a,b,...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threadCount == 0) threadCount = 1;
+    // A HAL do host inicializa no primeiro uso; faz isso antes das threads
+    halTimeUs();
+
+    // Confrontos: todos os pares, incluindo cada estratégia contra si mesma
+    typedef struct { uint32_t a, b; } Match;
+    std::vector<Match> matches;
+    for (size_t i = 0; i < selected.size(); i++)
+        for (size_t j = i; j < selected.size(); j++)
+            matches.push_back({selected[i], selected[j]});
+
+    // Tarefas distribuídas em rodízio; o desequilíbrio (negamax é mais lento)
+    // fica por conta do roubo
+    std::vector<TaskQueue> queues(threadCount);
+    uint32_t next = 0;
+    for (uint32_t m = 0; m < matches.size(); m++) {
+        for (uint64_t first = 0; first < gamesPerMatch; first += CHUNK_GAMES) {
+            uint32_t games = (uint32_t)std::min<uint64_t>(CHUNK_GAMES, gamesPerMatch - first);
+            queues[next++ % threadCount].tasks.push_back({matches[m].a, matches[m].b, m, first, games});
+        }
+    }
+
+    std::vector<WorkerResult> results(threadCount);
+    std::vector<std::thread> threads;
+    uint64_t start = nowNs();
+    for (uint32_t t = 0; t < threadCount; t++) {
+        results[t].tallies.assign(matches.size(), Tally());
+        results[t].times.assign(STRATEGY_COUNT, MoveTimes());
+        results[t].stolen = 0;
+        threads.emplace_back([&, t]() {
+            // TicTacToeAI tem a tabela de transposição inline: fica no heap
+            std::unique_ptr<Worker> worker(new Worker());
+            Task task;
+            bool stolen;
+            while (popTask(queues, t, task, stolen)) {
+                runTask(*worker, task, seed, results[t]);
+                if (stolen) results[t].stolen++;
+            }
+        });
+    }
+    for (std::thread &thread : threads) thread.join();
+    double seconds = (nowNs() - start) / 1e9;
+
+    // Soma das threads
+    std::vector<Tally> tallies(matches.size(), Tally());
+    std::vector<MoveTimes> times(STRATEGY_COUNT, MoveTimes());
+    uint64_t stolen = 0;
+    for (const WorkerResult &result : results) {
+        for (size_t m = 0; m < matches.size(); m++) {
+            for (int side = 0; side < 2; side++) {
+                tallies[m].wins[side] += result.tallies[m].wins[side];
+                tallies[m].draws[side] += result.tallies[m].draws[side];
+                tallies[m].losses[side] += result.tallies[m].losses[side];
+            }
+            tallies[m].timeNs += result.tallies[m].timeNs;
+        }
+        for (uint32_t s = 0; s < STRATEGY_COUNT; s++) {
+            MoveTimes &total = times[s];
+            const MoveTimes &part = result.times[s];
+            total.moves += part.moves;
+            total.totalNs += part.totalNs;
+            if (part.maxNs > total.maxNs) total.maxNs = part.maxNs;
+            for (uint32_t b = 0; b < TIME_BUCKETS; b++) total.buckets[b] += part.buckets[b];
+        }
+        stolen += result.stolen;
+    }
+
+    uint64_t totalGames = gamesPerMatch * matches.size();
+    printf("%llu partidas em %.2f s com %u threads: %.0f partidas/s (%llu tarefas roubadas)\n",
+           (unsigned long long)totalGames, seconds, threadCount, totalGames / seconds,
+           (unsigned long long)stolen);
+
+    printf("\n%-22s%-26s%-24s%s\n", "confronto (A x B)", "A começa: V/E/D %", "B começa: V/E/D %",
+           "partidas/s por thread");
+    int failures = 0;
+    for (size_t m = 0; m < matches.size(); m++) {
+        const Tally &t = tallies[m];
+        const Strategy &a = STRATEGIES[matches[m].a];
+        const Strategy &b = STRATEGIES[matches[m].b];
+        double perSide[2];
+        for (int side = 0; side < 2; side++) {
+            uint64_t games = t.wins[side] + t.draws[side] + t.losses[side];
+            perSide[side] = games ? 100.0 / games : 0;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "%s x %s", a.name, b.name);
+        printf("%-22s%5.1f/%5.1f/%5.1f         %5.1f/%5.1f/%5.1f       %10.0f\n", name,
+               t.wins[0] * perSide[0], t.draws[0] * perSide[0], t.losses[0] * perSide[0],
+               t.wins[1] * perSide[1], t.draws[1] * perSide[1], t.losses[1] * perSide[1],
+               t.timeNs ? gamesPerMatch * 1e9 / t.timeNs : 0);
+
+        // Jogo perfeito nunca perde: derrota de A é vitória de B e vice-versa
+        uint64_t aLosses = t.losses[0] + t.losses[1];
+        uint64_t bLosses = t.wins[0] + t.wins[1];
+        if (a.optimal && aLosses) {
+            printf("  FALHA: %s perdeu %llu partidas\n", a.name, (unsigned long long)aLosses);
+            failures++;
+        }
+        if (b.optimal && bLosses) {
+            printf("  FALHA: %s perdeu %llu partidas\n", b.name, (unsigned long long)bLosses);
+            failures++;
+        }
+    }
+
+    printf("\ntempo por jogada\n");
+    for (uint32_t s = 0; s < STRATEGY_COUNT; s++) printTimes(STRATEGIES[s].name, times[s]);
+    printf("\n");
+    for (uint32_t s : selected) printf("  %-8s %s\n", STRATEGIES[s].name, STRATEGIES[s].description);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,198 @@
+// Confere o log de partidas (GameLog) sobre a flash simulada do host:
+// ida e volta das partidas, queda de energia em cada byte gravado,
+// distribuição dos apagamentos entre os setores e persistência em arquivo.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include "Hal.hpp"
+#include "GameLog.hpp"
+
+#define ROUND_TRIP_GAMES 500
+#define WEAR_GAMES 40000
+#define SECTOR_RECORDS 313          // partidas de 9 jogadas (13 bytes) que enchem um setor
+#define POWER_CUT_BUDGETS 64
+#define SERVICE_LIMIT 16            // passos para esvaziar a fila de uma partida
+
+static uint32_t failures = 0;
+static std::vector<GameRecord> written;  // por número de partida
+
+static void fail(const char *what, uint32_t value) {
+    if (failures < 10) printf("falha: %s (%lu)\n", what, (unsigned long)value);
+    failures++;
+}
+
+static uint32_t rng = 12345;
+
+static uint32_t nextRandom() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Partida qualquer: casas distintas em ordem sorteada
+static GameRecord randomGame(uint8_t moveCount) {
+    GameRecord record;
+    uint8_t cells[GAME_LOG_MAX_MOVES] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    for (uint8_t i = GAME_LOG_MAX_MOVES - 1; i > 0; i--) {
+        uint8_t j = nextRandom() % (i + 1);
+        uint8_t t = cells[i];
+        cells[i] = cells[j];
+        cells[j] = t;
+    }
+    record.mode = nextRandom() % 2;
+    record.result = nextRandom() % 3;
+    record.moveCount = moveCount;
+    memcpy(record.moves, cells, moveCount);
+    return record;
+}
+
+static bool sameGame(const GameRecord &a, const GameRecord &b) {
+    return a.sequence == b.sequence && a.mode == b.mode && a.result == b.result &&
+           a.moveCount == b.moveCount && memcmp(a.moves, b.moves, a.moveCount) == 0;
+}
+
+// Como no fim do programa: o apagamento do reserva é um passo à parte
+static void drain(GameLog &log) {
+    for (uint32_t i = 0; i < SERVICE_LIMIT && log.busy(); i++) {
+        if (log.needsErase()) log.eraseSpare();
+        else log.service();
+    }
+}
+
+static uint32_t play(GameLog &log, uint8_t moveCount) {
+    GameRecord record = randomGame(moveCount);
+    if (!log.append(record)) fail("fila cheia", record.sequence);
+    if (written.size() <= record.sequence) written.resize(record.sequence + 1);
+    written[record.sequence] = record;
+    drain(log);
+    return record.sequence;
+}
+
+// Partidas de 'first' a 'last' lidas de um log recém-montado cuja partida
+// mais nova é 'newest' (índice 0)
+static void checkRange(const char *what, uint32_t first, uint32_t last, uint32_t newest) {
+    GameLog log;
+    log.mount();
+    for (uint32_t sequence = last; sequence >= first && sequence > 0; sequence--) {
+        GameRecord record;
+        if (!log.read(newest - sequence, record) || !sameGame(record, written[sequence])) {
+            fail(what, sequence);
+            return;
+        }
+    }
+}
+
+static void roundTrip() {
+    halFlashAttach(nullptr);
+    written.clear();
+    GameLog log;
+    log.mount();
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < ROUND_TRIP_GAMES; i++) last = play(log, 5 + i % 5);
+    checkRange("ida e volta", 1, last, last);
+}
+
+// Corta a energia depois de 'budget' bytes durante a gravação da partida
+// seguinte a 'preload' partidas de 9 jogadas; as antigas devem sobreviver
+// e a interrompida deve estar inteira ou ausente
+static bool powerCut(uint32_t preload, int32_t budget) {
+    halFlashAttach(nullptr);
+    written.clear();
+    uint32_t last = 0;
+    {
+        GameLog log;
+        log.mount();
+        for (uint32_t i = 0; i < preload; i++) last = play(log, 9);
+        halFlashPowerCut(budget);
+        play(log, 9);
+        halFlashPowerCut(-1);
+    }
+
+    GameLog log;
+    log.mount();
+    uint32_t stored = log.count();
+    if (stored != preload && stored != preload + 1) fail("partidas após a queda", budget);
+    uint32_t newest = (stored == preload + 1) ? last + 1 : last;
+    checkRange("partida antiga perdida na queda", 1, newest, newest);
+
+    // O log continua gravável depois da queda
+    uint32_t next = play(log, 7);
+    checkRange("gravação após a queda", 1, next, next);
+    return stored == preload + 1;
+}
+
+static void powerCuts() {
+    const uint32_t preloads[] = {0, 2, SECTOR_RECORDS};
+    for (uint32_t p = 0; p < sizeof(preloads) / sizeof(preloads[0]); p++) {
+        int32_t firstComplete = -1;
+        for (int32_t budget = 0; budget < POWER_CUT_BUDGETS; budget++) {
+            if (powerCut(preloads[p], budget) && firstComplete < 0) firstComplete = budget;
+        }
+        printf("queda de energia após %3lu partidas: %d orçamentos, partida inteira a partir de %d bytes\n",
+               (unsigned long)preloads[p], POWER_CUT_BUDGETS, firstComplete);
+    }
+}
+
+static void wear() {
+    halFlashAttach(nullptr);
+    written.clear();
+    GameLog log;
+    log.mount();
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < WEAR_GAMES; i++) last = play(log, 5 + nextRandom() % 5);
+
+    uint32_t minErases = UINT32_MAX, maxErases = 0;
+    uint32_t region = halFlashSize() - GAME_LOG_SECTORS * HAL_FLASH_SECTOR_SIZE;
+    for (uint8_t s = 0; s < GAME_LOG_SECTORS; s++) {
+        uint32_t erases = halFlashEraseCount(region + s * HAL_FLASH_SECTOR_SIZE);
+        if (erases < minErases) minErases = erases;
+        if (erases > maxErases) maxErases = erases;
+        if (erases != log.eraseCount(s)) fail("contagem de apagamentos do cabeçalho", s);
+    }
+    if (maxErases - minErases > 1) fail("desgaste desigual", maxErases - minErases);
+
+    GameLog mounted;
+    mounted.mount();
+    uint32_t stored = mounted.count();
+    checkRange("partida recente após voltas no anel", last - stored + 1, last, last);
+    printf("desgaste: %d partidas, apagamentos por setor %lu a %lu, %lu partidas guardadas (%.1f bytes cada)\n",
+           WEAR_GAMES, (unsigned long)minErases, (unsigned long)maxErases, (unsigned long)stored,
+           (double)(GAME_LOG_SECTORS - 1) * HAL_FLASH_SECTOR_SIZE / stored);
+}
+
+static void fileBacked() {
+    char path[] = "/tmp/game_log_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fail("arquivo temporário", 0);
+        return;
+    }
+    close(fd);
+
+    written.clear();
+    if (!halFlashAttach(path)) fail("abrir a flash em arquivo", 0);
+    uint32_t last = 0;
+    {
+        GameLog log;
+        log.mount();
+        for (uint32_t i = 0; i < 10; i++) last = play(log, 9);
+    }
+    // Reabre o arquivo, como num novo boot do simulador
+    halFlashAttach(path);
+    checkRange("partida do arquivo", 1, last, last);
+    halFlashAttach(nullptr);
+    unlink(path);
+}
+
+int main() {
+    roundTrip();
+    powerCuts();
+    wear();
+    fileBacked();
+    printf("falhas: %lu\n", (unsigned long)failures);
+    return failures != 0;
+}
@@ -0,0 +1,88 @@
+// Confere a tabela gerada em tempo de compilação contra um minimax exaustivo
+// em todas as posições alcançáveis e mede o custo de uma consulta.
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+#include "BitBoard.hpp"
+#include "SolvedTable.hpp"
+#include "TicTacToeAI.hpp"
+
+#define LOOKUP_ROUNDS 2000
+
+static int minimax(BitBoard& board, uint8_t player) {
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    uint8_t pieces = board.moveCount();
+    if (board.checkWin(opponent)) return -(TicTacToeAI::WIN_SCORE + BitBoard::CELL_COUNT - pieces);
+    if (pieces == BitBoard::CELL_COUNT) return 0;
+
+    int best = -100;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        int score = -minimax(board, opponent);
+        board.unmakeMove(cell, player);
+        if (score > best) best = score;
+    }
+    return best;
+}
+
+static BitBoard positions[SolvedTable::POSITION_COUNT];
+static uint32_t positionCount = 0;
+static uint32_t mismatches = 0;
+static bool visited[SolvedTable::POSITION_COUNT];
+
+static void walk(BitBoard& board, uint8_t player) {
+    uint16_t index = solvedTableIndex(board);
+    if (visited[index]) return;
+    visited[index] = true;
+
+    uint16_t entry = SOLVED_TABLE.entries[index];
+    if (board.checkWin(1) || board.checkWin(2) || board.isFull()) {
+        if (entry != 0) mismatches++;
+        return;
+    }
+
+    positions[positionCount++] = board;
+
+    uint16_t expected = 0;
+    int best = -100;
+    uint8_t opponent = (player == 1) ? 2 : 1;
+    for (uint8_t cell = 0; cell < BitBoard::CELL_COUNT; cell++) {
+        if (!board.isEmpty(cell)) continue;
+        board.makeMove(cell, player);
+        int score = -minimax(board, opponent);
+        walk(board, opponent);
+        board.unmakeMove(cell, player);
+        if (score > best) {
+            best = score;
+            expected = 1u << cell;
+        } else if (score == best) {
+            expected |= 1u << cell;
+        }
+    }
+
+    if (solvedBestMoves(entry) != expected || solvedScore(entry) != best) {
+        printf("divergência no índice %u\n", index);
+        mismatches++;
+    }
+}
+
+int main() {
+    BitBoard board;
+    walk(board, 1);
+
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < LOOKUP_ROUNDS; r++) {
+        uint32_t acc = 0;
+        for (uint32_t i = 0; i < positionCount; i++) acc += solvedLookup(positions[i]);
+        sink = sink + acc;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("posições alcançáveis não terminais: %lu\n", (unsigned long)positionCount);
+    printf("divergências: %lu\n", (unsigned long)mismatches);
+    printf("tabela: %u bytes (%u entradas)\n", (unsigned)sizeof(SOLVED_TABLE), (unsigned)SolvedTable::POSITION_COUNT);
+    printf("consulta: %.2f ns\n", seconds * 1e9 / ((double)LOOKUP_ROUNDS * positionCount));
+    return mismatches != 0;
+}
@@ -1,76 +1,191 @@
 #include <stdio.h>
-#include "pico/stdlib.h"
-#include "hardware/gpio.h"
+#include "Hal.hpp"
 #include "WS2812.hpp"
-#include "TicTacToeMic.hpp"
-
-// Protótipos das funções do modo joystick
-void initHardware();
-void drawBoard(WS2812 &ledStrip);
-void makeAIMove();
-void checkGameState(WS2812 &ledStrip);
-void processInput(WS2812 &ledStrip);
+#include "Input.hpp"
+#include "TicTacToe.hpp"
+#include "TicTacToeGrid.hpp"
+#include "TicTacToeUltimate.hpp"
+#include "EventLog.hpp"
+#include "GameLog.hpp"
+#include "BoardScheduler.hpp"
+#include "MatrixGeometry.hpp"
+#include "FrameStream.hpp"
+#include "EngineProtocol.hpp"
+#include "FrameBuffer.hpp"
+#include "BoardPicture.hpp"
+#include "BoardPalette.hpp"
 
 // Constantes
 #define LED_PIN 7
-#define LED_LENGTH 25
+#define LED_LENGTH PanelLayout::LED_COUNT // 5x5 no BitDogLab (MatrixGeometry.hpp)
 #define BUTTON_B_PIN 5 // Botão B físico do BitDogLab
+#define JOYSTICK_BUTTON_PIN 22
+#define LED_POWER_BUDGET_MA 500 // limite de corrente da matriz pela USB
+#define ENGINE_POLL_BYTES 64 // caracteres do protocolo de motor por passada do laço
+#define ENGINE_LOOP_MS 5
+
+// Placas IA x IA lado a lado, cada uma na sua fita (1 = só o jogo normal)
+#ifndef TICTACTOE_BOARDS
+#define TICTACTOE_BOARDS 1
+#endif
+
+// Fitas extras das placas 2..8 (a matriz do BitDogLab é a placa 1)
+static const uint BOARD_PINS[SCHEDULER_MAX_BOARDS - 1] = {8, 9, 16, 17, 18, 19, 20};
+
+// Placa 1 na matriz, as outras em painéis iguais com a máquina de estados
+// escolhida pelo registro; jogadores alternados para variar as partidas
+static void runBoards(WS2812 &matrix, uint8_t boards)
+{
+    static const PlayerKind KINDS[3] = {PLAYER_TABLE, PLAYER_NEGAMAX, PLAYER_RANDOM};
+    WS2812 *strips[SCHEDULER_MAX_BOARDS - 1] = {nullptr};
+    BoardScheduler scheduler;
+    scheduler.addBoard(matrix, PLAYER_TABLE, PLAYER_NEGAMAX);
+    for (uint8_t i = 1; i < boards && i < SCHEDULER_MAX_BOARDS; i++)
+    {
+        strips[i - 1] = new WS2812(BOARD_PINS[i - 1], LED_LENGTH);
+        strips[i - 1]->setPowerBudget(LED_POWER_BUDGET_MA);
+        if (!scheduler.addBoard(*strips[i - 1], KINDS[i % 3], KINDS[(i + 1) % 3]))
+            printf(">> Placa %u sem saída: ignorada\n", i + 1);
+    }
+    printf(">> %u placas IA x IA\n", scheduler.boardCount());
+    scheduler.run();
+    scheduler.printStats();
+    for (uint8_t i = 0; i < SCHEDULER_MAX_BOARDS - 1; i++)
+    {
+        if (strips[i]) strips[i]->printStats();
+        delete strips[i];
+    }
+}
+
+// Modo motor: um programa no computador joga ou mede a IA pelo protocolo
+// de EngineProtocol.hpp e a matriz mostra a posição a cada mudança
+static void runEngine(WS2812 &strip)
+{
+    EngineProtocol engine;
+    FrameBuffer frame(strip);
+    uint32_t drawn = engine.revision() - 1;
+    printf(">> Protocolo de motor: uci, position, go, ucinewgame\n");
+    while (halRunning() && !engine.quitRequested())
+    {
+        bool handled = engine.poll(ENGINE_POLL_BYTES);
+        if (engine.revision() != drawn)
+        {
+            drawn = engine.revision();
+            uint8_t size = engine.boardSize();
+            frame.clear(COLOR_OFF);
+            if (size == 3)
+            {
+                BoardPicture::attach(frame);
+                BoardPicture::drawGrid(frame, COLOR_GRID);
+            }
+            else
+            {
+                frame.centerArea(size, size);
+            }
+            for (uint8_t cell = 0; cell < size * size; cell++)
+            {
+                uint8_t player = engine.cell(cell);
+                if (player == 0) continue;
+                WS2812::Color color = player == 1 ? COLOR_PLAYER1 : COLOR_PLAYER2;
+                if (size == 3) BoardPicture::setCell(frame, cell, color);
+                else frame.setPixel(cell % size, cell / size, color);
+            }
+            strip.show();
+        }
+        if (!handled) halSleepMs(ENGINE_LOOP_MS);
+    }
+}
 
 int main()
 {
-    stdio_init_all();
+    halInit();
 
     // Inicializa botão B
-    gpio_init(BUTTON_B_PIN);
-    gpio_set_dir(BUTTON_B_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_B_PIN); // botão ativo em LOW
-
-    sleep_ms(100); // estabiliza leitura após reset
+    halGpioInitInput(BUTTON_B_PIN, true); // botão ativo em LOW
 
-    // Lê o estado do botão B no momento do boot
-    bool pressionado = !gpio_get(BUTTON_B_PIN); // LOW = pressionado
+    halSleepMs(100); // estabiliza leitura após reset
 
+    // Modo de entrada inicial pelo botão B no boot; depois, segurar o B
+    // por um segundo troca de modo a qualquer momento
+    bool pressionado = !halGpioGet(BUTTON_B_PIN); // LOW = pressionado
     if (!pressionado)
-    {
-        // Modo padrão = MIC
         printf(">> Botão B NÃO pressionado no reset: iniciando modo MICROFONE\n");
-        TicTacToeMic game;
-        game.run();
-    }
     else
-    {
-        // Só entra no modo joystick se o botão B estiver pressionado
         printf(">> Botão B pressionado no reset: iniciando modo JOYSTICK\n");
 
-        initHardware();
-        WS2812 ledStrip(LED_PIN, LED_LENGTH, pio0, 0, WS2812::FORMAT_GRB);
-        drawBoard(ledStrip);
+    InputLayer input(pressionado ? INPUT_JOYSTICK : INPUT_MIC);
+    input.start();
+    WS2812 ledStrip(LED_PIN, LED_LENGTH, pio0, 0);
+    ledStrip.setPowerBudget(LED_POWER_BUDGET_MA);
+    halSleepMs(1); // primeiras amostras do round-robin
 
-        while (true)
-        {
-            extern bool gameActive;
-            extern uint8_t currentPlayer;
+    GameLog gameLog;
+    gameLog.mount();
+    printf(">> %lu partidas gravadas na flash\n", (unsigned long)gameLog.count());
 
-            if (gameActive)
-            {
-                if (currentPlayer == 1)
-                {
-                    sleep_ms(500);
-                    makeAIMove();
-                    drawBoard(ledStrip);
-                    checkGameState(ledStrip);
-                }
-                else
-                {
-                    processInput(ledStrip);
-                }
-            }
-            else
-            {
-                processInput(ledStrip); // permite reinício
-            }
+    // Variante escolhida pelo joystick no boot: botão pressionado = 5x5
+    // com 4 em linha (com o B também = replay das partidas gravadas),
+    // alavanca para os lados = 4x4 com 3 em linha, alavanca para
+    // cima/baixo = Ultimate Tic-Tac-Toe, alavanca na diagonal = modo stream
+    // (quadros vindos do computador pela USB; com o B também = protocolo de
+    // motor para jogar contra a IA pela USB)
+    int xValue = input.adcLatest(0);
+    int yValue = input.adcLatest(1);
+    bool lateral = yValue < 1000 || yValue > 3000;
+    bool vertical = xValue < 1000 || xValue > 3000;
 
-            sleep_ms(10);
-        }
+    if (TICTACTOE_BOARDS > 1)
+    {
+        runBoards(ledStrip, TICTACTOE_BOARDS);
+    }
+    else if (pressionado && !halGpioGet(JOYSTICK_BUTTON_PIN))
+    {
+        printf(">> B e joystick pressionados: replay das partidas gravadas\n");
+        TicTacToe game(ledStrip, input, gameLog);
+        game.runReplay();
+    }
+    else if (!halGpioGet(JOYSTICK_BUTTON_PIN))
+    {
+        printf(">> Joystick pressionado: tabuleiro 5x5, 4 em linha\n");
+        TicTacToeGrid<5, 4> game(ledStrip, input);
+        game.run();
+    }
+    else if (lateral && vertical && pressionado)
+    {
+        printf(">> B e joystick na diagonal: protocolo de motor pela USB\n");
+        runEngine(ledStrip);
+    }
+    else if (lateral && vertical)
+    {
+        printf(">> Joystick na diagonal: modo stream, quadros pela USB\n");
+        FrameStream stream(ledStrip);
+        stream.run();
+    }
+    else if (lateral)
+    {
+        printf(">> Joystick para o lado: tabuleiro 4x4, 3 em linha\n");
+        TicTacToeGrid<4, 3> game(ledStrip, input);
+        game.run();
+    }
+    else if (vertical)
+    {
+        printf(">> Joystick para cima/baixo: Ultimate Tic-Tac-Toe\n");
+        TicTacToeUltimate game(ledStrip, input);
+        game.run();
+    }
+    else
+    {
+        TicTacToe game(ledStrip, input, gameLog);
+        game.run();
+    }
+
+    // Roteiro do simulador encerrado: termina a gravação, esvazia o log e
+    // mostra os números da fita
+    while (gameLog.busy())
+    {
+        if (gameLog.needsErase()) gameLog.eraseSpare();
+        else gameLog.service();
     }
+    while (logFlush() > 0) {}
+    ledStrip.printStats();
 }